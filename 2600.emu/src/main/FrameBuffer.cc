@@ -130,17 +130,14 @@ void FrameBuffer::renderOutput(MutablePixmapView pix, TIA& tia)
 	}
 	else
 	{
-		pix.writeTransformed([this](uint8_t p)
-			{
-				if constexpr(outputBits == 16)
-				{
-					return tiaColorMap16[p];
-				}
-				else
-				{
-					return tiaColorMap32[p];
-				}
-			}, framePix);
+		if constexpr(outputBits == 16)
+		{
+			pix.writeLookup<uint16_t>(tiaColorMap16, framePix);
+		}
+		else
+		{
+			pix.writeLookup<uint32_t>(tiaColorMap32, framePix);
+		}
 	}
 }
 
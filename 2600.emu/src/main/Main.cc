@@ -137,6 +137,7 @@ static void renderVideo(EmuSystemTaskContext taskCtx, EmuVideo& video, FrameBuff
 	auto fmt = video.renderPixelFormat();
 	auto img = video.startFrameWithFormat(taskCtx, {{(int)tia.width(), (int)tia.height()}, fmt});
 	fb.render(img.pixmap(), tia);
+	video.addCopiedBytes(img.pixmap().unpaddedBytes());
 	img.endFrame();
 }
 
@@ -55,6 +55,8 @@ struct AppMeta
 	static constexpr double minFrameRate{48.};
 	static const F2Size validFrameRateRange;
 	static const bool stateSizeChangesAtRuntime;
+	static const bool compressesSaveStates;
+	static const bool hasLargeGuestMemory; // allocates emulated memory with EmuSystem::makeGuestMemory()
 	static const bool hasIcon;
 	static const bool needsGlobalInstance;
 	static const bool handlesRecentContent;
@@ -66,6 +68,8 @@ struct AppMeta
 	static const std::span<const BundledGameInfo> bundledGameInfo;
 
 	static bool hasBundledGames() { return bundledGameInfo.size(); }
+	// return false for content the core must read through ArchiveIO, like CD images with companion files
+	static bool canExtractArchiveEntry(std::string_view name, size_t size);
 
 	// Input
 	static std::span<const KeyCategory> keyCategories();
@@ -44,6 +44,8 @@ protected:
 	TextMenuItem soundBuffersItem[7];
 	MultiChoiceMenuItem soundBuffers;
 	BoolMenuItem addSoundBuffersOnUnderrun;
+	TextMenuItem resamplerItem[2];
+	MultiChoiceMenuItem resampler;
 	StaticArrayList<TextMenuItem, 5> audioRateItem;
 	MultiChoiceMenuItem audioRate;
 	ConditionalMember<Audio::Manager::HAS_SOLO_MIX, BoolMenuItem> audioSoloMix;
@@ -0,0 +1,71 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/defs.hh>
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/audio/Format.hh>
+#endif
+#ifndef IG_USE_MODULE_STD
+#include <array>
+#include <vector>
+#include <cmath>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+enum class AudioResamplerType : uint8_t
+{
+	nearest,
+	sinc,
+};
+
+// Streaming windowed-sinc resampler using a polyphase coefficient table with linear
+// interpolation between phases. A short input history is kept between calls so
+// it can be fed the variable sized chunks produced by each emulated frame.
+
+class SincResampler
+{
+public:
+	static constexpr int taps = 16;
+	static constexpr int phases = 64;
+
+	void reset() { needsReset = true; }
+	bool isActive() const { return !needsReset; }
+	// ratio is input frames per output frame, returns the number of frames written to dest
+	size_t resample(void *dest, size_t maxDestFrames, const void *src, size_t srcFrames, Audio::Format, double ratio);
+
+	static size_t maxOutputFrames(size_t srcFrames, double ratio)
+	{
+		return std::ceil(srcFrames / ratio) + 1;
+	}
+
+private:
+	std::array<float, (phases + 1) * taps> coeffs{};
+	std::array<float, taps * 2> history{};
+	std::vector<float> buff; // planar channel data, history followed by the new input
+	double pos{};
+	float cutoff{};
+	int8_t channels{};
+	bool needsReset{true};
+
+	void makeCoeffs(float cutoff);
+};
+
+}
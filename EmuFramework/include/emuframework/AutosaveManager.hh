@@ -45,6 +45,8 @@ enum class AutosaveLaunchMode: uint8_t
 };
 
 enum class LoadAutosaveMode{Normal, NoState};
+// WaitForWrite blocks until the state file is written so callers about to switch slots or exit can check the result
+enum class SaveAutosaveMode{Normal, WaitForWrite};
 enum class AutosaveActionSource{Auto, Manual};
 
 inline constexpr std::string_view defaultAutosaveFilename = "auto-00";
@@ -55,7 +57,9 @@ class AutosaveManager
 {
 public:
 	AutosaveManager(EmuApp &);
-	bool save(AutosaveActionSource src = AutosaveActionSource::Auto);
+	bool save(AutosaveActionSource src, SaveAutosaveMode m);
+	bool save(SaveAutosaveMode m) { return save(AutosaveActionSource::Auto, m); }
+	bool save(AutosaveActionSource src = AutosaveActionSource::Auto) { return save(src, SaveAutosaveMode::Normal); }
 	bool load(AutosaveActionSource src, LoadAutosaveMode m);
 	bool load(LoadAutosaveMode m) { return load(AutosaveActionSource::Auto, m); }
 	bool load(AutosaveActionSource src = AutosaveActionSource::Auto) { return load(src, LoadAutosaveMode::Normal); }
@@ -90,7 +94,7 @@ private:
 	std::string autoSaveSlot;
 	FileIO stateIO;
 
-	bool saveState();
+	bool saveState(SaveAutosaveMode);
 	bool loadState();
 
 public:
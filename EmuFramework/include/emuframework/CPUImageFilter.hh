@@ -0,0 +1,59 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/pixmap/MemPixmap.hh>
+#include <imagine/thread/ThreadPool.hh>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+enum class CPUImageFilterId: uint8_t
+{
+	NONE,
+	SCALE2X,
+	SCALE3X,
+};
+
+// Scales frames on the CPU before they're uploaded to the video texture. The core renders
+// into an intermediate buffer at its native size, then the output is split into bands of
+// rows that are filtered in parallel on the app's thread pool and the calling thread.
+
+class CPUImageFilter
+{
+public:
+	using Id = CPUImageFilterId;
+
+	CPUImageFilter() = default;
+	void setId(Id);
+	Id id() const { return id_; }
+	int scale() const;
+	PixmapDesc setInputFormat(PixmapDesc);
+	PixmapDesc inputDesc() const { return inputPix.desc(); }
+	MutablePixmapView inputPixmap() const { return inputPix.view(); }
+	void run(ThreadPool &, MutablePixmapView dest, PixmapView src);
+	explicit operator bool() const { return id_ != Id::NONE; }
+
+private:
+	MemPixmap inputPix;
+	Id id_{};
+};
+
+}
@@ -26,6 +26,7 @@
 #include <emuframework/AutosaveManager.hh>
 #include <emuframework/RecentContent.hh>
 #include <emuframework/RewindManager.hh>
+#include <emuframework/SaveStateWriter.hh>
 #include <emuframework/AssetManager.hh>
 #include <emuframework/InputManager.hh>
 #include <emuframework/AppMeta.hh>
@@ -48,6 +49,7 @@
 #include <imagine/font/Font.hh>
 #include <imagine/util/used.hh>
 #include <imagine/util/enum.hh>
+#include <imagine/thread/ThreadPool.hh>
 #endif
 #ifndef IG_USE_MODULE_STD
 #include <cstring>
@@ -135,9 +137,9 @@ public:
 	FS::PathString contentSavePath(std::string_view name) const;
 	FS::PathString contentSaveFilePath(std::string_view ext) const;
 	void setupStaticBackupMemoryFile(FileIO &, std::string_view ext, size_t staticSize, uint8_t initValue = 0) const;
-	void readState(std::span<uint8_t> buff);
+	void readState(FileIO &);
 	size_t writeState(std::span<uint8_t> buff, SaveStateFlags = {});
-	DynArray<uint8_t> saveState();
+	void setRewindMemory(uint16_t mib);
 	bool saveState(CStringView path, bool notify);
 	bool saveStateWithSlot(int slot, bool notify);
 	bool loadState(CStringView path);
@@ -190,6 +192,7 @@ public:
 	void applyOSNavStyle(ApplicationContext, bool inEmu);
 	void setCPUNeedsLowLatency(ApplicationContext, bool needed);
 	void reportFrameWorkDuration(Nanoseconds);
+	ThreadPool &threadPool();
 	void renderSystemFramebuffer(EmuVideo &);
 	void renderSystemFramebuffer() { renderSystemFramebuffer(video); }
 	bool writeScreenshot(PixmapView, CStringView path);
@@ -201,10 +204,12 @@ public:
 	Viewport makeViewport(const Window &win) const;
 	void setEmuViewOnExtraWindow(bool on, Screen &);
 	void record(FrameTimingStatEvent, SteadyClockTimePoint t = {});
-	void runBenchmarkOneShot(EmuVideo &);
+	void exportFrameTimingTrace();
+	BenchmarkResult runBenchmarkOneShot(EmuVideo &, int frames = defaultBenchmarkFrames);
 	void onSelectFileFromPicker(IO, CStringView path, std::string_view displayName,
 		const Input::Event &, EmuSystemCreateParams, ViewAttachParams);
 	void handleOpenFileCommand(CStringView path);
+	void runBenchmarkFromCommandLine(CStringView path);
 	EmuSystem &system();
 	const EmuSystem &system() const;
 	ApplicationContext appContext() const { return system().appContext(); }
@@ -248,6 +253,8 @@ public:
 	void setCPUAffinity(int cpuNumber, bool on);
 	bool cpuAffinity(int cpuNumber) const;
 	void applyCPUAffinity(bool active);
+	std::vector<ThreadId> threadIds(ThreadRole) const;
+	CPUMask threadPlacementMask(ThreadPlacement) const;
 
 	// GUI Options
 	void setIdleDisplayPowerSave(bool on);
@@ -266,6 +273,7 @@ public:
 	void setLayoutBehindSystemUI(bool);
 	bool doesLayoutBehindSystemUI() const { return layoutBehindSystemUI; };
 	void setLowLatencyVideo(bool);
+	void setTripleBufferVideo(bool);
 
 	void postMessage(UTF16Convertible auto &&msg)
 	{
@@ -320,10 +328,12 @@ public:
 	EmuVideo video;
 	EmuVideoLayer videoLayer;
 	AutosaveManager autosaveManager{*this};
+	SaveStateWriter stateWriter{*this};
 	InputManager inputManager;
-	RewindManager rewindManager{*this};
+	RewindManager rewindManager;
 	AssetManager assetManager;
 	FrameTimingStats frameTimingStats;
+	FrameTimingTrace frameTimingTrace;
 	OutputTimingManager outputTimingManager;
 	EmuSystemTask systemTask{*this};
 	[[no_unique_address]] VibrationManager vibrationManager;
@@ -406,6 +416,11 @@ public:
 	{
 		.defaultValue = true
 	}> confirmOverwriteState;
+	Property<SaveStateFormat, CFGKEY_SAVE_STATE_FORMAT,
+	{
+		.defaultValue = SaveStateFormat::lz4,
+		.isValid = isValidWithMax<SaveStateFormat::lz4>
+	}> saveStateFormat;
 	Property<int8_t, CFGKEY_SAVE_STATE_SLOT,
 	{
 		.isValid = isValidWithMinMax<0, 9>
@@ -433,6 +448,8 @@ public:
 	{
 		.defaultValue = CPUAffinityMode::Auto
 	}> cpuAffinityMode;
+	ConditionalProperty<Config::cpuAffinity, ThreadPlacements, CFGKEY_THREAD_PLACEMENT> threadPlacement;
+	ConditionalProperty<Config::cpuAffinity, ThreadPriority, CFGKEY_THREAD_PRIORITY> threadPriority;
 	ConditionalMember<Config::envIsAndroid && Config::DEBUG_BUILD, bool> useNoopThread{};
 	ConditionalProperty<Gfx::supportsPresentModes, Gfx::PresentMode, CFGKEY_RENDERER_PRESENT_MODE,
 	{
@@ -448,6 +465,17 @@ public:
 	{
 		.defaultValue = true
 	}> lowLatencyVideo;
+	Property<bool, CFGKEY_TRIPLE_BUFFER_VIDEO> tripleBufferVideo;
+	Property<int8_t, CFGKEY_LATE_START_MARGIN,
+	{
+		.isValid = isValidWithMinMax<0, maxLateStartMarginMSecs>
+	}> lateStartMarginMSecs; // 0 disables delaying emulation until just before the next frame is needed
+	Property<int8_t, CFGKEY_RUN_AHEAD_FRAMES,
+	{
+		.isValid = isValidWithMinMax<0, maxRunAheadFrames>
+	}> runAheadFrames;
+	Property<bool, CFGKEY_GUEST_MEMORY_HUGE_PAGES> guestMemoryHugePages;
+	Property<bool, CFGKEY_LOCK_GUEST_MEMORY> lockGuestMemory;
 
 protected:
 	struct ConfigParams
@@ -458,8 +486,12 @@ protected:
 	[[no_unique_address]] Data::PixmapWriter pixmapWriter;
 	[[no_unique_address]] PerformanceHintManager perfHintManager;
 	[[no_unique_address]] PerformanceHintSession perfHintSession;
+	ThreadPriority appliedThreadPriority{};
+	ThreadPool threadPool_; // for short parallel jobs from the framework and cores, started on first use
+	bool threadPoolStarted{};
 	ConditionalMember<MOGA_INPUT, std::unique_ptr<Input::MogaManager>> mogaManagerPtr;
 	ConditionalMember<Config::TRANSLUCENT_SYSTEM_UI, bool> layoutBehindSystemUI{};
+	int benchmarkFrames{}; // set by --benchmark, runs the launch content without a window or pacing then exits
 
 	void onMainWindowCreated(ViewAttachParams, const Input::Event &);
 	ConfigParams loadConfigFile(ApplicationContext);
@@ -467,6 +499,7 @@ protected:
 	void saveConfigFile(FileIO &);
 	void initOptions(ApplicationContext);
 	void applyRenderPixelFormat();
+	void applyThreadPriority(std::span<const ThreadId>, bool active);
 	FS::PathString sessionConfigPath();
 	void loadSystemOptions();
 	void saveSystemOptions();
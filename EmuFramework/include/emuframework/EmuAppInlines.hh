@@ -274,6 +274,13 @@ IG::Rotation EmuSystem::contentRotation() const
 	return {};
 }
 
+int EmuSystem::stateCompressionLevel() const
+{
+	if(&MainSystem::stateCompressionLevel != &EmuSystem::stateCompressionLevel)
+		return static_cast<const MainSystem*>(this)->stateCompressionLevel();
+	return 6; // zlib default
+}
+
 void EmuSystem::onStart()
 {
 	if(&MainSystem::onStart != &EmuSystem::onStart)
@@ -286,12 +293,24 @@ void EmuSystem::onStop()
 		static_cast<MainSystem*>(this)->onStop();
 }
 
+void EmuSystem::onSpeedMultiplierChanged(double speed)
+{
+	if(&MainSystem::onSpeedMultiplierChanged != &EmuSystem::onSpeedMultiplierChanged)
+		static_cast<MainSystem*>(this)->onSpeedMultiplierChanged(speed);
+}
+
 void EmuSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
 {
 	if(&MainSystem::addThreadGroupIds != &EmuSystem::addThreadGroupIds)
 		static_cast<const MainSystem*>(this)->addThreadGroupIds(ids);
 }
 
+void EmuSystem::addIOThreadIds(std::vector<ThreadId> &ids) const
+{
+	if(&MainSystem::addIOThreadIds != &EmuSystem::addIOThreadIds)
+		static_cast<const MainSystem*>(this)->addIOThreadIds(ids);
+}
+
 Cheat* EmuSystem::newCheat(EmuApp& app, const char* name, CheatCodeDesc desc)
 {
 	if(&MainSystem::newCheat != &EmuSystem::newCheat)
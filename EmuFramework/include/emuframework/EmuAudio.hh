@@ -16,12 +16,14 @@
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <emuframework/EmuOptions.hh>
+#include <emuframework/AudioResampler.hh>
 #ifndef IG_USE_MODULE_IMAGINE
 #include <imagine/audio/OutputStream.hh>
 #include <imagine/audio/Manager.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/util/container/RingBuffer.hh>
 #include <imagine/util/used.hh>
+#include <imagine/thread/Thread.hh>
 #endif
 #ifndef IG_USE_MODULE_STD
 #include <memory>
@@ -52,6 +54,11 @@ struct AudioFlags
 
 inline constexpr AudioFlags defaultAudioFlags{.enabled = 1, .enabledDuringAltSpeed = 1};
 
+struct AudioWriteParams
+{
+	bool speedAdjusted{}; // frames are already at the rate of the current speed multiplier
+};
+
 class EmuAudio
 {
 public:
@@ -69,12 +76,13 @@ public:
 	void stop();
 	void close();
 	void flush();
-	void writeFrames(const void *samples, size_t framesToWrite);
+	void writeFrames(const void *samples, size_t framesToWrite, AudioWriteParams params = {});
 	void setRate(int rate);
 	int rate() const { return rate_; }
 	int maxRate() const { return defaultRate; }
 	void setStereo(bool on);
 	void setSpeedMultiplier(double speed);
+	double speed() const { return speedMultiplier; }
 	float volume() const { return currentVolume; }
 	bool setMaxVolume(int8_t vol);
 	int8_t maxVolume() const { return std::round(maxVolume_ * 100.f); }
@@ -85,6 +93,8 @@ public:
 	void setEnabledDuringAltSpeed(bool on);
 	bool isEnabledDuringAltSpeed() const;
 	Audio::Format format() const;
+	void setCallbackThreadCPUAffinityMask(CPUMask); // applied by the output callback thread the next time it runs
+	ThreadId callbackThreadId() const { return callbackThreadId_.load(std::memory_order::relaxed); }
 	explicit operator bool() const { return bool(rBuff.capacity()); }
 	void writeConfig(FileIO &) const;
 	bool readConfig(MapIO &, unsigned key);
@@ -93,15 +103,26 @@ public:
 protected:
 	Audio::OutputStream audioStream;
 	RingBuffer<uint8_t, RingBufferConf{.mirrored = true}> rBuff;
+	SincResampler sincResampler;
 	SteadyClockTimePoint lastUnderrunTime{};
 	double speedMultiplier{1.};
+	double nearestFramesRemainder{};
+	SteadyClockTimePoint lastBufferIncreaseTime{};
 	size_t targetBufferFillBytes{};
+	size_t baseBufferFillBytes{};
 	size_t bufferIncrementBytes{};
+	double smoothedFillBytes{};
+	double fillErrorIntegral{};
+	double rateCorrection_{1.};
 	int defaultRate;
 	int rate_;
 	float maxVolume_{1.};
 	float currentVolume{1.};
 	std::atomic<AudioWriteState> audioWriteState{AudioWriteState::BUFFER};
+	std::atomic<ThreadId> callbackThreadId_{};
+	std::atomic<CPUMask> callbackThreadCPUMask{};
+	std::atomic_bool callbackThreadNeedsSetup{};
+	bool hasCallbackThreadCPUMask{};
 	int8_t channels{2};
 	AudioFlags flags{defaultAudioFlags};
 	ConditionalMember<Audio::Config::MULTIPLE_SYSTEM_APIS, Audio::Api> audioAPI{};
@@ -112,14 +133,23 @@ public:
 	{
 		.defaultValue = 2, .isValid = isValidWithMinMax<1, 7>
 	}> soundBuffers;
+	Property<AudioResamplerType, CFGKEY_AUDIO_FRAMEWORK_RESAMPLER,
+	{
+		.defaultValue = AudioResamplerType::sinc, .isValid = isValidWithMax<AudioResamplerType::sinc>
+	}> resamplerType;
 
 	size_t framesFree() const;
 	size_t framesWritten() const;
 	size_t framesCapacity() const;
 	bool shouldStartAudioWrites(size_t bytesToWrite = 0) const;
+	void updateRateCorrection(size_t inputFrames);
+	double rateCorrection() const { return rateCorrection_; }
+	FloatSeconds latency() const { return format().bytesToTime(rBuff.size()); }
+	size_t resample(void *dest, size_t destFrames, const void *src, size_t srcFrames, double ratio);
 	void resizeAudioBuffer(size_t targetBufferFillBytes);
 	void updateVolume();
 	void updateAddBuffersOnUnderrun();
+	void setupCallbackThread();
 };
 
 }
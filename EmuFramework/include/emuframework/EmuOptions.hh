@@ -91,7 +91,13 @@ enum ConfigKey { CFGKEY_SOUND = 0, CFGKEY_TOUCH_CONTROL_DISPLAY = 1,
 	CFGKEY_REWIND_STATES = 118, CFGKEY_REWIND_TIMER_SECS = 119,
 	CFGKEY_FRAME_CLOCK = 120, CFGKEY_INPUT_DEVICE_CONTENT_CONFIGS = 121,
 	CFGKEY_SHOW_FRAME_TIMING_STATS = 122, CFGKEY_OUTPUT_FRAME_RATE_MODE = 123,
-	CFGKEY_SAVE_STATE_SLOT = 124,
+	CFGKEY_SAVE_STATE_SLOT = 124, CFGKEY_REWIND_MEMORY = 125,
+	CFGKEY_REWIND_FRAME_INTERVAL = 126, CFGKEY_AUDIO_FRAMEWORK_RESAMPLER = 127,
+	CFGKEY_RUN_AHEAD_FRAMES = 128, CFGKEY_SAVE_STATE_FORMAT = 129,
+	CFGKEY_RECENT_CONTENT_ARCHIVE_ENTRY = 130, CFGKEY_CPU_IMAGE_FILTER = 131,
+	CFGKEY_TRIPLE_BUFFER_VIDEO = 132, CFGKEY_LATE_START_MARGIN = 133,
+	CFGKEY_GUEST_MEMORY_HUGE_PAGES = 134, CFGKEY_LOCK_GUEST_MEMORY = 135,
+	CFGKEY_THREAD_PLACEMENT = 136, CFGKEY_THREAD_PRIORITY = 137,
 	// 256+ is reserved
 };
 
@@ -151,6 +157,9 @@ inline constexpr bool imageEffectPixelFormatIsValid(const auto &v)
 	}
 }
 
+inline constexpr int8_t maxRunAheadFrames = 4;
+inline constexpr int8_t maxLateStartMarginMSecs = 16;
+
 template<auto max>
 constexpr bool isValidWithMax(const auto &v)
 {
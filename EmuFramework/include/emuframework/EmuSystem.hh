@@ -27,10 +27,12 @@
 #include <imagine/audio/Format.hh>
 #include <imagine/util/rectangle2.h>
 #include <imagine/util/memory/DynArray.hh>
+#include <imagine/vmem/memory.hh>
 #endif
 #ifndef IG_USE_MODULE_STD
 #include <string>
 #include <string_view>
+#include <optional>
 #endif
 
 #ifndef IG_USE_MODULE_IMAGINE
@@ -72,9 +74,28 @@ struct CheatCodeDesc
 	unsigned flags{};
 };
 
+// Location of the content file inside an archive, cached to skip scanning on the next load
+struct ArchiveEntryInfo
+{
+	FS::FileString name;
+	uint32_t index{};
+	uint32_t crc32{};
+	uint64_t size{};
+
+	explicit operator bool() const { return name.size(); }
+};
+
+struct ContentMapFlags
+{
+	uint8_t
+	// map pages privately so the core can patch or decrypt them without changing the file
+	copyOnWrite:1{};
+};
+
 struct EmuSystemCreateParams
 {
 	uint8_t systemFlags;
+	ArchiveEntryInfo archiveEntry{};
 };
 
 enum class ConfigType : uint8_t
@@ -101,6 +122,32 @@ struct SaveStateFlags
 	uint8_t uncompressed:1{};
 };
 
+inline constexpr int defaultBenchmarkFrames = 180;
+
+struct BenchmarkResult
+{
+	SteadyClockDuration totalTime{};
+	SteadyClockDuration medianFrameTime{};
+	SteadyClockDuration p99FrameTime{};
+	int frames{};
+	uint64_t frameHash{};
+	uint64_t stateHash{};
+	std::optional<uint64_t> tlbMisses{}; // data TLB misses while running frames, if the CPU counter is readable
+
+	double framesPerSecond() const { return frames / duration_cast<FloatSeconds>(totalTime).count(); }
+};
+
+// 64-bit FNV-1a, used to check emulation output is deterministic across runs
+constexpr uint64_t fnv1aHash(std::span<const uint8_t> data, uint64_t hash = 0xcbf29ce484222325)
+{
+	for(auto b : data)
+	{
+		hash ^= b;
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
 class EmuSystem
 {
 public:
@@ -179,9 +226,12 @@ public:
 	bool resetSessionOptions(EmuApp &);
 	void savePathChanged();
 	bool shouldFastForward() const;
+	void onSpeedMultiplierChanged(double speed); // called with the emulation thread suspended
 	FS::FileString contentDisplayNameForPath(CStringView path) const;
 	Rotation contentRotation() const;
-	void addThreadGroupIds(std::vector<ThreadId> &) const;
+	int stateCompressionLevel() const; // gzip level for cores that compress their states
+	void addThreadGroupIds(std::vector<ThreadId> &) const; // helper threads that work on each frame
+	void addIOThreadIds(std::vector<ThreadId> &) const; // background threads reading media
 	Cheat* newCheat(EmuApp&, const char* name, CheatCodeDesc);
 	bool setCheatName(Cheat&, const char* name);
 	std::string_view cheatName(const Cheat&) const;
@@ -199,7 +249,7 @@ public:
 	bool isStarted() const { return state == State::ACTIVE || state == State::PAUSED; }
 	bool isPaused() const { return state == State::PAUSED; }
 	void loadState(EmuApp &, CStringView uri);
-	void saveState(CStringView uri);
+	void loadState(EmuApp &, FileIO &);
 	DynArray<uint8_t> saveState();
 	DynArray<uint8_t> uncompressGzipState(std::span<uint8_t> buff, size_t expectedSize = 0);
 	bool stateExists(int slot) const;
@@ -218,6 +268,7 @@ public:
 	}
 	const auto &contentName() const { return contentName_; }
 	FS::FileString contentFileName() const;
+	const ArchiveEntryInfo &contentArchiveEntry() const { return contentArchiveEntry_; }
 	std::string contentDisplayName() const;
 	void setContentDisplayName(std::string_view name);
 	FS::FileString contentDisplayNameForPathDefaultImpl(CStringView path) const;
@@ -277,6 +328,12 @@ public:
 	bool updateBackupMemoryCounter();
 	bool usesBackupMemory() const;
 	FileIO openStaticBackupMemoryFile(CStringView uri, size_t staticSize, uint8_t initValue = 0) const;
+	MapIO mapContent(IO &, ContentMapFlags = {}) const;
+	// huge pages only help large emulated memories, so they're applied to these aligned allocations
+	UniqueVPtr<uint8_t> makeGuestMemory(size_t bytes) const { return makeUniqueVPtr<uint8_t>(bytes, guestMemoryFlags); }
+	// existing memory, like static arrays in a core, can only be locked
+	void applyGuestMemoryFlags(std::span<uint8_t> mem) const { vApplyFlags(mem, {.locked = guestMemoryFlags.locked}); }
+	void applyGuestMemoryFlags(auto &arr) const { applyGuestMemoryFlags(asWritableBytes(arr)); }
 	void sessionOptionSet();
 	void resetSessionOptionsSet() { sessionOptionsSet = false; }
 	bool sessionOptionsAreSet() const { return sessionOptionsSet; }
@@ -303,7 +360,7 @@ public:
 	static double audioMixRate(int outputRate, FrameRate inputFrameRate, FrameRate outputFrameRate);
 	double audioMixRate(int outputRate, FrameRate outputFrameRate) const { return audioMixRate(outputRate, frameRate(), outputFrameRate); }
 	void configFrameRate(int outputRate, FrameDuration outputFrameDuration);
-	SteadyClockDuration benchmark(EmuVideo&);
+	BenchmarkResult benchmark(EmuVideo*, int frames = defaultBenchmarkFrames);
 	bool hasContent() const;
 	void resetFrameTiming();
 	void pause(EmuApp &);
@@ -320,6 +377,7 @@ protected:
 	ApplicationContext appCtx{};
 public:
 	EmuTiming timing;
+	VMemFlags guestMemoryFlags{}; // for large emulated memories, set by the app before loading content
 protected:
 	double audioFramesPerVideoFrameFloat{};
 	double currentAudioFramesPerVideoFrame{};
@@ -331,6 +389,7 @@ protected:
 	FS::PathString contentDirectory_; // full directory path of content on disk, if any
 	FS::PathString contentLocation_; // full path or URI to content
 	FS::FileString contentFileName_; // name + extension of content, inside archive if any
+	ArchiveEntryInfo contentArchiveEntry_;
 	FS::FileString contentName_; // name of content from the original location without extension
 	std::string contentDisplayName_; // more descriptive content name set by system
 	FS::PathString contentSaveDirectory_;
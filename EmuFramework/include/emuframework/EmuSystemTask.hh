@@ -19,12 +19,16 @@
 #ifndef IG_USE_MODULE_IMAGINE
 #include <imagine/base/MessagePort.hh>
 #include <imagine/thread/Thread.hh>
+#include <imagine/thread/ThreadUsageCounter.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/util/variant.hh>
 #include <imagine/util/ScopeGuard.hh>
+#include <imagine/util/memory/DynArray.hh>
 #endif
 #ifndef IG_USE_MODULE_STD
 #include <flat_map>
+#include <string>
+#include <vector>
 #endif
 
 namespace EmuEx
@@ -67,6 +71,50 @@ private:
 	static constexpr int wantedConsistentFrames = 128;
 };
 
+// Learns how long running a frame takes from recent samples so its start can be delayed
+// until just enough time is left before the next frame is due
+
+class FrameWorkPredictor
+{
+public:
+	constexpr FrameWorkPredictor() = default;
+	void addDuration(SteadyClockDuration);
+	SteadyClockDuration estimatedDuration() const { return estimate; } // zero until enough samples are collected
+	void reset() { *this = {}; }
+
+private:
+	static constexpr size_t maxDurations = 120;
+	static constexpr size_t minDurations = 30;
+	std::array<SteadyClockDuration, maxDurations> durations{};
+	uint8_t nextIdx{};
+	uint8_t storedDurations{};
+	SteadyClockDuration estimate{};
+};
+
+// Samples the CPU time and CPU migrations of each thread role once a second for the frame timing stats
+
+class ThreadUsageStats
+{
+public:
+	ThreadUsageStats() = default;
+	void update(const EmuApp&, SteadyClockTimePoint now);
+	std::string_view summary() const { return summary_; }
+
+private:
+	struct ThreadCounter
+	{
+		ThreadRole role{};
+		ThreadUsageCounter counter;
+		ThreadUsage lastUsage;
+	};
+
+	std::vector<ThreadCounter> threads;
+	SteadyClockTimePoint lastUpdateTime{};
+	std::string summary_;
+
+	void addNewThreads(const EmuApp&);
+};
+
 class EmuSystemTask
 {
 public:
@@ -148,7 +196,10 @@ private:
 	binary_semaphore suspendSem{0};
 	FrameRateConfig frameRateConfig;
 	int savedAdvancedFrames{};
+	DynArray<uint8_t> runAheadState;
 	FrameRateDetector frameRateDetector;
+	FrameWorkPredictor frameWorkPredictor;
+	ThreadUsageStats threadUsageStats;
 	ConditionalMember<Config::multipleScreenFrameRates, std::flat_map<SteadyClockDuration, FrameRate>> detectedFrameRateMap;
 public:
 	bool enableBlankFrameInsertion{};
@@ -172,6 +223,11 @@ private:
 	void calibrateScreenFrameRate(FrameRate);
 	void setWindowInternal(Window&);
 	void drawWindowNow();
+	void updateRunAheadState();
+	size_t runFramesAhead(EmuVideo&);
+	void restoreRunAheadState(size_t size);
+	void disableRunAhead(std::string_view error);
+	void delayFrameStart(FrameParams);
 };
 
 }
@@ -22,6 +22,9 @@ import std;
 #else
 #include <imagine/time/Time.hh>
 #include <imagine/util/used.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <atomic>
+#include <string>
 #endif
 
 namespace EmuEx
@@ -50,6 +53,39 @@ struct FrameTimingStats
 	ConditionalMember<enableFullFrameTimingStats, SteadyClockTimePoint> waitForPresent{};
 	SteadyClockTimePoint endOfFrame{};
 	ConditionalMember<enableFullFrameTimingStats, int> missedFrameCallbacks{};
+	SteadyClockDuration runAheadTime{}; // extra time spent per frame on run-ahead
+	SteadyClockDuration lateStartDelay{}; // time emulation start was held back to finish just before the next frame
+	int droppedFrames{}; // triple buffered frames replaced before the renderer showed them
+	int duplicatedFrames{}; // renderer draws that re-used the previous triple buffered frame
+};
+
+struct FrameTimingTraceEntry
+{
+	SteadyClockTimePoint startOfFrame{};
+	SteadyClockTimePoint startOfEmulation{};
+	SteadyClockTimePoint waitForPresent{};
+	SteadyClockTimePoint endOfFrame{};
+	uint32_t audioFramesWritten{};
+};
+
+// Fixed size ring of per-frame timestamps for offline analysis, recorded on the emulation thread
+// without allocating and read back on the main thread as Chrome trace event JSON
+class FrameTimingTrace
+{
+public:
+	static constexpr size_t defaultFrames = 3600;
+
+	bool isEnabled() const { return entries.size(); }
+	void setEnabled(bool on, size_t frames = defaultFrames);
+	void record(FrameTimingStatEvent, SteadyClockTimePoint);
+	void commitFrame(size_t audioFramesWritten);
+	size_t recordedFrames() const { return std::min(committedFrames.load(std::memory_order::acquire), entries.size()); }
+	std::string chromeTraceJson() const;
+
+private:
+	DynArray<FrameTimingTraceEntry> entries;
+	FrameTimingTraceEntry current;
+	std::atomic_size_t committedFrames{};
 };
 
 class EmuTiming
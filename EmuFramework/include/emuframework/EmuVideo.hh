@@ -18,6 +18,7 @@
 #include <emuframework/EmuAppHelper.hh>
 #include <emuframework/EmuSystemTask.hh>
 #include <emuframework/EmuSystemTaskContext.hh>
+#include <emuframework/CPUImageFilter.hh>
 #ifndef IG_USE_MODULE_IMAGINE
 #include <imagine/gfx/PixmapBufferTexture.hh>
 #endif
@@ -34,6 +35,7 @@ class [[nodiscard]] EmuVideoImage
 public:
 	constexpr EmuVideoImage() = default;
 	EmuVideoImage(EmuSystemTaskContext, EmuVideo&, Gfx::LockedTextureBuffer);
+	EmuVideoImage(EmuSystemTaskContext, EmuVideo&, MutablePixmapView filterInput);
 	MutablePixmapView pixmap() const;
 	explicit operator bool() const;
 	void endFrame();
@@ -42,12 +44,13 @@ protected:
 	EmuSystemTaskContext taskCtx;
 	EmuVideo* emuVideo{};
 	Gfx::LockedTextureBuffer texBuff;
+	MutablePixmapView pix;
 };
 
 class EmuVideo : public EmuAppHelper
 {
 public:
-	constexpr EmuVideo() = default;
+	EmuVideo(ApplicationContext ctx): appCtx{ctx} {}
 	void setRendererTask(Gfx::RendererTask&);
 	bool hasRendererTask() const;
 	bool setFormat(PixmapDesc, EmuSystemTaskContext _ = {});
@@ -62,12 +65,17 @@ public:
 	void finishFrame(EmuSystemTaskContext, Gfx::LockedTextureBuffer);
 	void finishFrame(EmuSystemTaskContext, PixmapView);
 	void clear();
+	// waits for the renderer to finish reading a frame passed to finishFrame(PixmapView),
+	// call before modifying the core's frame buffer outside of running a frame
+	void awaitPendingFrameWrite();
 	void takeGameScreenshot();
+	void requestFrameHash() { hashNextFrame = true; }
 	bool isExternalTexture() const;
 	Gfx::PixmapBufferTexture& image();
 	Gfx::Renderer& renderer() const;
 	ApplicationContext appContext() const;
 	WSize size() const;
+	WSize outputSize() const;
 	bool formatIsEqual(PixmapDesc desc) const;
 	void setTextureBufferMode(EmuSystem&, Gfx::TextureBufferMode);
 	void setSampler(Gfx::TextureSamplerConfig);
@@ -75,24 +83,40 @@ public:
 	bool setRenderPixelFormat(EmuSystem&, PixelFormat, Gfx::ColorSpace);
 	PixelFormat renderPixelFormat() const;
 	PixelFormat internalRenderPixelFormat() const;
+	bool setCPUImageFilter(CPUImageFilterId);
+	CPUImageFilterId cpuImageFilterId() const { return cpuFilter.id(); }
+	// bytes of the last frame that were copied or converted from a core's private buffer
+	// in a separate pass, zero when the core rendered its scanlines directly into the image
+	size_t lastFrameCopiedBytes() const { return lastFrameCopiedBytes_; }
+	// for cores that convert their own frame buffer into the image from startFrame()
+	void addCopiedBytes(size_t bytes) { copiedBytes += bytes; }
 	static Gfx::TextureSamplerConfig samplerConfigForLinearFilter(bool useLinearFilter);
 	static MutablePixmapView takeInterlacedFields(MutablePixmapView, bool isOddField);
 
 protected:
+	ApplicationContext appCtx;
 	Gfx::RendererTask* rTask{};
 	Gfx::PixmapBufferTexture vidImg;
+	MemPixmap headlessImg; // holds frames for hashing when there's no renderer task, like in the command line benchmark
+	CPUImageFilter cpuFilter;
 	PixelFormat renderFmt;
 	Gfx::TextureBufferMode bufferMode{};
 	bool screenshotNextFrame{};
+	bool hashNextFrame{};
 	Gfx::ColorSpace colSpace{Gfx::ColorSpace::LINEAR};
 	bool useLinearFilter{true};
+	bool hasPendingFrameWrite{};
+	size_t copiedBytes{};
+	size_t lastFrameCopiedBytes_{};
 
 	void doScreenshot(EmuSystemTaskContext, PixmapView);
+	void doFrameHash(PixmapView);
 	void postFrameFinished(EmuSystemTaskContext);
 	Gfx::TextureSamplerConfig samplerConfig() const { return samplerConfigForLinearFilter(useLinearFilter); }
 
 public:
 	bool isOddField{};
+	uint64_t frameHash{};
 };
 
 }
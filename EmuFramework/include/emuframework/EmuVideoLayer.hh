@@ -18,6 +18,7 @@
 #include <emuframework/VideoImageOverlay.hh>
 #include <emuframework/VideoImageEffect.hh>
 #include <emuframework/EmuOptions.hh>
+#include <emuframework/CPUImageFilter.hh>
 #ifndef IG_USE_MODULE_IMAGINE
 #include <imagine/gfx/Quads.hh>
 #include <imagine/gfx/Vec3.hh>
@@ -57,6 +58,8 @@ public:
 	void setEffect(EmuSystem &, ImageEffectId, PixelFormat);
 	ImageEffectId effectId() const { return userEffectId; }
 	void updateEffect(EmuSystem &, PixelFormat);
+	void setCPUFilter(EmuSystem &, CPUImageFilterId, PixelFormat);
+	CPUImageFilterId cpuFilterId() const { return userCPUFilterId; }
 	void setEffectFormat(PixelFormat);
 	void setLinearFilter(bool on);
 	bool usingLinearFilter() const { return useLinearFilter; }
@@ -103,6 +106,7 @@ public:
 private:
 	ImageEffectId userEffectId{};
 	ImageOverlayId userOverlayEffectId{};
+	CPUImageFilterId userCPUFilterId{};
 	Gfx::ColorSpace colSpace{};
 public:
 	Property<uint8_t, CFGKEY_CONTENT_SCALE,
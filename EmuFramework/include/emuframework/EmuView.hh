@@ -40,6 +40,10 @@ struct FrameTimingViewStats
 	FrameTimingStats stats;
 	SteadyClockTimePoint lastFrameTime;
 	FrameRate inputRate, outputRate;
+	FloatSeconds audioLatency{};
+	double audioRateCorrection{1.};
+	size_t videoCopiedBytes{};
+	std::string_view threadUsage;
 };
 
 class EmuView : public View
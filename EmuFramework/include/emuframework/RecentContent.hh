@@ -15,6 +15,7 @@
 	You should have received a copy of the GNU General Public License
 	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
 
+#include <emuframework/EmuSystem.hh>
 #ifdef IG_USE_MODULES
 import imagine;
 import std;
@@ -38,6 +39,7 @@ struct RecentContentInfo
 {
 	FS::PathString path;
 	FS::FileString name;
+	ArchiveEntryInfo archiveEntry;
 
 	constexpr bool operator==(RecentContentInfo const& rhs) const
 	{
@@ -48,8 +50,9 @@ struct RecentContentInfo
 class RecentContent
 {
 public:
-	void add(std::string_view path, std::string_view name);
+	void add(std::string_view path, std::string_view name, const ArchiveEntryInfo & = {});
 	void add(const EmuSystem &);
+	ArchiveEntryInfo archiveEntry(std::string_view path) const;
 	size_t size() const { return recentContentList.size(); }
 	auto begin() const { return recentContentList.begin(); }
 	auto end() const { return recentContentList.end(); }
@@ -58,9 +61,11 @@ public:
 	void writeContent(FileIO&) const;
 	bool readConfig(MapIO&, unsigned key);
 	bool readContent(MapIO&, const EmuSystem&);
+	bool readArchiveEntry(MapIO&);
 
 private:
 	std::vector<RecentContentInfo> recentContentList;
+	bool skippedLastContent{};
 public:
 	static constexpr uint8_t defaultMaxRecentContent{20};
 	uint8_t maxRecentContent{defaultMaxRecentContent};
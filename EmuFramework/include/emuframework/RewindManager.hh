@@ -17,8 +17,10 @@
 
 #include <emuframework/defs.hh>
 #ifndef IG_USE_MODULE_IMAGINE
-#include <imagine/base/PausableTimer.hh>
-#include <imagine/util/memory/FlexArray.hh>
+#include <imagine/thread/WorkThread.hh>
+#include <imagine/thread/Semaphore.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/memory/DynArray.hh>
 
 namespace IG
 {
@@ -26,6 +28,12 @@ class MapIO;
 class FileIO;
 }
 #endif
+#ifndef IG_USE_MODULE_STD
+#include <deque>
+#include <array>
+#include <atomic>
+#include <mutex>
+#endif
 
 namespace EmuEx
 {
@@ -33,48 +41,121 @@ namespace EmuEx
 using namespace IG;
 
 class EmuApp;
+class EmuSystem;
+
+inline constexpr uint16_t maxRewindMemoryMiB = 1024;
+inline constexpr uint16_t defaultRewindFrameInterval = 60;
+inline constexpr uint16_t maxRewindFrameInterval = 600;
+
+// Keeps the newest state in full and older states as XOR deltas run-length encoded
+// against their successor, stored in a ring buffer sized by the memory budget.
+// Rewinding applies deltas in place to the full state, so no separate keyframes are needed.
+// States are captured on the emulation thread into pooled buffers and encoded on a worker thread.
 
 class RewindManager
 {
 public:
-	RewindManager(EmuApp &);
+	struct HistoryStats
+	{
+		size_t states{};
+		size_t bytes{};
+		double compressionRatio{1.};
+	};
+
+	RewindManager() = default;
+	~RewindManager();
 	void clear();
 	bool reset();
-	void rewindState(EmuApp &);
-	void startTimer();
-	void pauseTimer();
-	void resetTimer();
+	void pause();
+	void captureFrames(EmuSystem &, int frames);
+	bool rewindFrames(EmuApp &, int frames);
 	bool readConfig(MapIO &, unsigned key);
 	void writeConfig(FileIO &) const;
+	bool isEnabled() const { return maxMemoryMiB; }
+	HistoryStats historyStats() const;
+	void setFrameInterval(uint16_t frames);
+
+	void setRewinding(bool on)
+	{
+		if(on)
+			rewindRequested.store(true, std::memory_order::relaxed);
+		rewinding.store(on, std::memory_order::relaxed);
+	}
 
-	void updateMaxStates(size_t max)
+	bool isRewinding() const
 	{
-		maxStates = max;
-		reset();
+		return rewinding.load(std::memory_order::relaxed) || rewindRequested.load(std::memory_order::relaxed);
+	}
+
+	bool updateMaxMemory(uint16_t mib)
+	{
+		maxMemoryMiB = mib;
+		return reset();
 	}
 
 	bool reset(size_t stateSize_)
 	{
 		stateSize = stateSize_;
+		migrateMaxStates();
 		return reset();
 	}
 
 private:
-	struct StateEntry
+	struct DeltaEntry
+	{
+		size_t offset{};
+		uint32_t size{};
+		uint32_t stateSize{}; // size of the state this delta restores
+	};
+
+	enum class CaptureStatus : uint8_t { free, captured };
+
+	struct CaptureSlot
 	{
+		DynArray<uint8_t> state;
 		size_t size{};
-		uint8_t data[];
+		uint32_t sequence{};
+		std::atomic<CaptureStatus> status{};
 	};
 
-	FlexArray<StateEntry> stateEntries;
-	size_t stateIdx{};
+	static constexpr Microseconds captureTimeBudget{500}; // average cost per emulated frame
+
+	mutable std::mutex mutex; // guards the full state & delta ring, held by the worker while encoding
+	std::mutex intervalMutex; // guards the frame intervals, which the UI thread can change while running
+	std::array<CaptureSlot, 2> captureSlots;
+	DynArray<uint8_t> lastState;
+	DynArray<uint8_t> encodeBuff;
+	DynArray<uint8_t> deltaBuff;
+	std::deque<DeltaEntry> deltas;
+	WorkThread encodeThread;
+	binary_semaphore encodeSem{0};
+	std::atomic_bool encodePending{};
+	std::atomic_bool rewinding{};
+	std::atomic_bool rewindRequested{};
+	size_t writeOffset{};
+	size_t lastStateSize{};
+	size_t deltaBytes{};
+	size_t deltaStateBytes{};
+	uint32_t captureSequence{};
+	uint32_t encodedSequence{};
+	int framesSinceCapture{};
+	int framesSinceRewind{};
+	uint16_t captureInterval{defaultRewindFrameInterval};
+	uint32_t oldMaxStates{}; // from the old state count option, converted once the state size is known
 public:
 	size_t stateSize{};
-	size_t maxStates{};
-	PausableTimer<Seconds> saveTimer;
+	uint16_t maxMemoryMiB{};
+	uint16_t frameInterval{defaultRewindFrameInterval};
 
 private:
-	void saveState(EmuApp &);
+	void freeBuffers();
+	void startEncodeThread();
+	void stopEncodeThread();
+	void encodeCapturedStates();
+	void storeDelta(std::span<const uint8_t> delta, size_t prevStateSize);
+	void popOldestDelta();
+	void clearDeltas();
+	void migrateMaxStates();
 };
 
 }
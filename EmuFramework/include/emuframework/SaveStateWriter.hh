@@ -0,0 +1,77 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/defs.hh>
+#include <emuframework/StateContainer.hh>
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/thread/WorkThread.hh>
+#include <imagine/thread/Semaphore.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/memory/DynArray.hh>
+#include <imagine/util/string/CStringView.hh>
+#endif
+#ifndef IG_USE_MODULE_STD
+#include <atomic>
+#include <string>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+class EmuSystem;
+
+// Snapshots save states into a reused buffer while the emulation thread is suspended,
+// then compresses (into a state container or the core's legacy format) and writes them
+// on a worker thread. Files are written to a temporary name and renamed over the
+// destination, so an interrupted write never leaves a truncated state.
+
+class SaveStateWriter
+{
+public:
+	SaveStateWriter(EmuApp &app): app{app} {}
+	~SaveStateWriter();
+	void write(EmuSystem &, CStringView uri, bool notify);
+	bool flush(); // waits for a pending write, returns false if the last write failed
+	bool isWriting() const { return writePending.load(std::memory_order::acquire); }
+	// also used to decode states when loading, call flush() before using them
+	DynArray<uint8_t> &buffer() { return stateBuff; }
+	DynArray<uint8_t> &scratchBuffer() { return compressBuff; }
+
+private:
+	EmuApp &app;
+	DynArray<uint8_t> stateBuff;
+	DynArray<uint8_t> compressBuff;
+	size_t stateSize{};
+	FS::PathString uri;
+	std::string error;
+	WorkThread writeThread;
+	binary_semaphore writeSem{0};
+	std::atomic_bool writePending{};
+	int compressionLevel{};
+	SaveStateFormat format{};
+	bool notify{};
+	bool resultPending{};
+
+	void startWriteThread();
+	void writeFile();
+	void reportResult();
+};
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/defs.hh>
+#ifndef IG_USE_MODULE_IMAGINE
+#include <imagine/util/memory/DynArray.hh>
+
+namespace IG
+{
+class FileIO;
+}
+#endif
+#ifndef IG_USE_MODULE_STD
+#include <array>
+#include <span>
+#include <cstdint>
+#endif
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+enum class SaveStateFormat : uint8_t
+{
+	legacy, // raw or gzip, as written by the core
+	lz4,
+};
+
+enum class StateCodec : uint8_t
+{
+	none,
+	lz4,
+};
+
+// Save state container: a fixed header followed by the payload split into independently
+// compressed blocks, each prefixed by its compressed size, so it can be decoded while streaming
+// from the file directly into the destination buffer. All fields are little-endian.
+struct StateContainerHeader
+{
+	std::array<char, 4> magic;
+	uint16_t version;
+	StateCodec codec;
+	uint8_t reserved;
+	uint32_t coreId;
+	uint32_t blockSize;
+	uint64_t uncompressedSize;
+	uint64_t checksum;
+};
+
+static_assert(sizeof(StateContainerHeader) == 32);
+
+inline constexpr std::array<char, 4> stateContainerMagic{'E', 'X', 'S', 'T'};
+inline constexpr uint16_t stateContainerVersion = 1;
+inline constexpr uint32_t stateContainerBlockSize = 256 * 1024;
+
+size_t maxStateContainerSize(size_t stateSize);
+size_t writeStateContainer(std::span<uint8_t> dest, std::span<const uint8_t> state, StateCodec);
+// Decodes into buff, using blockBuff for compressed blocks and growing either if needed.
+// Returns an empty span if the file isn't a container, throws if it's malformed, from another core,
+// or claims an uncompressed size over maxSize
+std::span<uint8_t> readStateContainer(FileIO &, DynArray<uint8_t> &buff, DynArray<uint8_t> &blockBuff, size_t maxSize);
+uint64_t stateChecksum(std::span<const uint8_t>);
+
+}
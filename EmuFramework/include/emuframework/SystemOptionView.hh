@@ -40,16 +40,21 @@ protected:
 	MultiChoiceMenuItem autosaveLaunch;
 	BoolMenuItem autosaveContent;
 	BoolMenuItem confirmOverwriteState;
+	TextMenuItem stateFormatItem[2];
+	MultiChoiceMenuItem stateFormat;
 	TextMenuItem fastModeSpeedItem[6];
 	MultiChoiceMenuItem fastModeSpeed;
 	TextMenuItem slowModeSpeedItem[3];
 	MultiChoiceMenuItem slowModeSpeed;
-	TextMenuItem rewindStatesItem[4];
-	MultiChoiceMenuItem rewindStates;
+	TextMenuItem rewindMemoryItem[5];
+	MultiChoiceMenuItem rewindMemory;
 	DualTextMenuItem rewindTimeInterval;
+	DualTextMenuItem rewindHistory;
 	ConditionalMember<Config::envIsAndroid, BoolMenuItem> performanceMode;
 	ConditionalMember<Config::envIsAndroid && Config::DEBUG_BUILD, BoolMenuItem> noopThread;
 	ConditionalMember<Config::cpuAffinity, TextMenuItem> cpuAffinity;
+	ConditionalMember<Config::envIsLinux || Config::envIsAndroid, BoolMenuItem> guestMemoryHugePages;
+	BoolMenuItem lockGuestMemory;
 	TextHeadingMenuItem autosaveHeading;
 	TextHeadingMenuItem rewindHeading;
 	TextHeadingMenuItem otherHeading;
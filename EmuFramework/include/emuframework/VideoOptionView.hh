@@ -56,6 +56,8 @@ protected:
 	BoolMenuItem imgFilter;
 	TextMenuItem imgEffectItem[6];
 	MultiChoiceMenuItem imgEffect;
+	TextMenuItem cpuFilterItem[3];
+	MultiChoiceMenuItem cpuFilter;
 	TextMenuItem overlayEffectItem[8];
 	MultiChoiceMenuItem overlayEffect;
 	TextMenuItem overlayEffectLevelItem[5];
@@ -23,6 +23,9 @@ import std;
 #include <imagine/config/defs.hh>
 #include <imagine/bluetooth/defs.hh>
 #include <imagine/util/Point2D.hh>
+#include <imagine/util/enum.hh>
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <concepts>
 #include <string_view>
@@ -63,6 +66,36 @@ enum class CPUAffinityMode: std::uint8_t
 	Auto, Any, Manual
 };
 
+enum class ThreadRole: std::uint8_t
+{
+	Emulation, Renderer, CoreHelper, Audio, IO
+};
+
+// Default uses the CPU affinity mode for the threads working on each frame and leaves others alone
+enum class ThreadPlacement: std::uint8_t
+{
+	Default, Any, Performance, Efficiency
+};
+
+struct ThreadPlacements
+{
+	std::array<ThreadPlacement, enumCount<ThreadRole>> roles{};
+
+	constexpr ThreadPlacement operator[](ThreadRole r) const { return roles[std::to_underlying(r)]; }
+	constexpr ThreadPlacement& operator[](ThreadRole r) { return roles[std::to_underlying(r)]; }
+	constexpr bool operator==(const ThreadPlacements&) const = default;
+
+	static constexpr bool isValid(const ThreadPlacements& p)
+	{
+		return std::ranges::all_of(p.roles, [](auto placement) { return enumIsValid(placement); });
+	}
+};
+
+enum class ThreadPriority: std::uint8_t
+{
+	Normal, High, Realtime
+};
+
 struct AudioStats
 {
 	int underruns{};
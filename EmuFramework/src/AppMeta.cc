@@ -30,6 +30,8 @@ namespace EmuEx
 [[gnu::weak]] const bool AppMeta::handlesGenericIO{true};
 [[gnu::weak]] const bool AppMeta::hasCheats{};
 [[gnu::weak]] const bool AppMeta::stateSizeChangesAtRuntime{};
+[[gnu::weak]] const bool AppMeta::compressesSaveStates{};
+[[gnu::weak]] const bool AppMeta::hasLargeGuestMemory{};
 [[gnu::weak]] const bool AppMeta::hasSound{true};
 [[gnu::weak]] const int AppMeta::forcedSoundRate{};
 [[gnu::weak]] const Audio::SampleFormat AppMeta::audioSampleFormat{Audio::SampleFormats::i16};
@@ -40,6 +42,7 @@ namespace EmuEx
 [[gnu::weak]] const std::span<const BundledGameInfo> AppMeta::bundledGameInfo{};
 
 [[gnu::weak]] bool AppMeta::allowsTurboModifier(KeyCode) { return true; }
+[[gnu::weak]] bool AppMeta::canExtractArchiveEntry(std::string_view, size_t) { return true; }
 [[gnu::weak]] std::unique_ptr<View> AppMeta::makeEditCheatsView(ViewAttachParams, CheatsView&) { return {}; }
 [[gnu::weak]] std::unique_ptr<View> AppMeta::makeEditCheatView(ViewAttachParams, Cheat&, BaseEditCheatsView&) { return {}; }
 [[gnu::weak]] void AppMeta::onCustomizeNavView(AppNavView&) {}
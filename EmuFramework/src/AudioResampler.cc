@@ -0,0 +1,136 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/AudioResampler.hh>
+import imagine;
+
+namespace EmuEx
+{
+
+// GCC/Clang vector extensions, lowered to SSE2 on x86 and NEON on ARM
+using float4 = float __attribute__((vector_size(16)));
+static_assert(SincResampler::taps % 4 == 0);
+constexpr int tapVecs = SincResampler::taps / 4;
+
+static float4 loadFloat4(const float *p)
+{
+	float4 v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static float readSample(const void *src, size_t idx, Audio::SampleFormat fmt)
+{
+	if(fmt.isFloat())
+		return static_cast<const float*>(src)[idx];
+	return static_cast<const int16_t*>(src)[idx] * (1.f / 32768.f);
+}
+
+static void writeSample(void *dest, size_t idx, float s, Audio::SampleFormat fmt)
+{
+	if(fmt.isFloat())
+		static_cast<float*>(dest)[idx] = s;
+	else
+		static_cast<int16_t*>(dest)[idx] = std::clamp(s * 32768.f, -32768.f, 32767.f);
+}
+
+void SincResampler::makeCoeffs(float cutoff_)
+{
+	cutoff = cutoff_;
+	constexpr double pi = std::numbers::pi;
+	for(auto p : iotaCount(phases + 1))
+	{
+		auto row = &coeffs[p * taps];
+		double frac = double(p) / phases;
+		double sum{};
+		for(auto j : iotaCount(taps))
+		{
+			// distance of this tap from the output position, in input frames
+			double x = j - (taps / 2 - 1) - frac;
+			double t = (x + taps / 2) / taps;
+			double window = 0.42 - 0.5 * std::cos(2. * pi * t) + 0.08 * std::cos(4. * pi * t); // Blackman
+			double sinc = x == 0. ? 1. : std::sin(pi * cutoff * x) / (pi * cutoff * x);
+			row[j] = cutoff * sinc * window;
+			sum += row[j];
+		}
+		// normalize for unity gain at DC
+		for(auto j : iotaCount(taps))
+			row[j] /= sum;
+	}
+}
+
+size_t SincResampler::resample(void *dest, size_t maxDestFrames, const void *src, size_t srcFrames,
+	Audio::Format fmt, double ratio)
+{
+	assume(fmt.channels == 1 || fmt.channels == 2);
+	if(needsReset || channels != fmt.channels)
+	{
+		needsReset = false;
+		channels = fmt.channels;
+		history = {};
+		pos = taps / 2 - 1;
+	}
+	// lower the cutoff when downsampling to avoid aliasing, with a small margin for the transition band
+	float newCutoff = std::min(1., 1. / ratio) * .95f;
+	if(std::abs(newCutoff - cutoff) > .01f)
+		makeCoeffs(newCutoff);
+	auto buffFrames = taps + srcFrames;
+	if(buff.size() < buffFrames * channels)
+		buff.resize(buffFrames * channels);
+	for(auto ch : iotaCount(channels))
+	{
+		auto plane = &buff[ch * buffFrames];
+		std::copy_n(&history[ch * taps], taps, plane);
+		for(auto i : iotaCount(srcFrames))
+			plane[taps + i] = readSample(src, i * channels + ch, fmt.sample);
+	}
+	size_t destFrames{};
+	// the last tap must stay within the buffered input
+	const double endPos = buffFrames - taps / 2;
+	while(destFrames < maxDestFrames && pos < endPos)
+	{
+		auto idx = size_t(pos);
+		auto phasePos = float(pos - idx) * phases;
+		auto phase = int(phasePos);
+		auto phaseFrac = phasePos - phase;
+		auto row0 = &coeffs[phase * taps];
+		auto row1 = row0 + taps;
+		float4 coeffVecs[tapVecs];
+		for(auto k : iotaCount(tapVecs))
+		{
+			auto c0 = loadFloat4(row0 + k * 4);
+			coeffVecs[k] = c0 + (loadFloat4(row1 + k * 4) - c0) * phaseFrac;
+		}
+		auto start = idx - (taps / 2 - 1);
+		for(auto ch : iotaCount(channels))
+		{
+			auto in = &buff[ch * buffFrames + start];
+			float4 acc{};
+			for(auto k : iotaCount(tapVecs))
+				acc += coeffVecs[k] * loadFloat4(in + k * 4);
+			writeSample(dest, destFrames * channels + ch, acc[0] + acc[1] + acc[2] + acc[3], fmt.sample);
+		}
+		destFrames++;
+		pos += ratio;
+	}
+	pos -= srcFrames;
+	// only possible if the output was truncated, drop the unconsumed input
+	pos = std::max(pos, double(taps / 2 - 1));
+	for(auto ch : iotaCount(channels))
+		std::copy_n(&buff[ch * buffFrames + srcFrames], taps, &history[ch * taps]);
+	return destFrames;
+}
+
+}
@@ -42,7 +42,7 @@ AutosaveManager::AutosaveManager(EmuApp &app_):
 		}
 	} {}
 
-bool AutosaveManager::save(AutosaveActionSource src)
+bool AutosaveManager::save(AutosaveActionSource src, SaveAutosaveMode mode)
 {
 	if(autoSaveSlot == noAutosaveName)
 		return true;
@@ -50,7 +50,7 @@ bool AutosaveManager::save(AutosaveActionSource src)
 	system().flushBackupMemory(app);
 	if(saveOnlyBackupMemory && src == AutosaveActionSource::Auto)
 		return true;
-	return saveState();
+	return saveState(mode);
 }
 
 bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
@@ -62,6 +62,7 @@ bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 		system().loadBackupMemory(app);
 		if(saveOnlyBackupMemory && src == AutosaveActionSource::Auto)
 			return true;
+		app.stateWriter.flush();
 		if(!stateIO)
 			stateIO = appContext().openFileUri(statePath(), OpenFlags::createFile());
 		if(stateIO.getExpected<uint8_t>(0)) // check if state contains data
@@ -76,7 +77,7 @@ bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 		else
 		{
 			log.info("autosave state doesn't exist, creating");
-			return saveState();
+			return saveState(SaveAutosaveMode::Normal);
 		}
 	}
 	catch(std::exception &err)
@@ -89,17 +90,25 @@ bool AutosaveManager::load(AutosaveActionSource src, LoadAutosaveMode mode)
 	}
 }
 
-bool AutosaveManager::saveState()
+bool AutosaveManager::saveState(SaveAutosaveMode mode)
 {
 	log.info("saving autosave state");
-	stateIO.truncate(0);
-	auto state = app.saveState();
-	if(stateIO.write(state.span(), 0).bytes != ssize_t(state.size()))
+	stateIO = {}; // the writer replaces the file, re-open it on the next load
+	try
+	{
+		{
+			auto suspendCtx = app.suspendEmulationThread();
+			app.stateWriter.write(system(), statePath(), false);
+		}
+		if(mode == SaveAutosaveMode::WaitForWrite)
+			return app.stateWriter.flush(); // write errors are posted by the writer
+		return true;
+	}
+	catch(std::exception &err)
 	{
-		app.postErrorMessage(4, "Error writing autosave state");
+		app.postErrorMessage(4, std::format("Error writing autosave state:\n{}", err.what()));
 		return false;
 	}
-	return true;
 }
 
 bool AutosaveManager::loadState()
@@ -107,7 +116,7 @@ bool AutosaveManager::loadState()
 	log.info("loading autosave state");
 	try
 	{
-		app.readState(stateIO.buffer(IOBufferMode::Direct));
+		app.readState(stateIO);
 		return true;
 	}
 	catch(std::exception &err)
@@ -121,7 +130,7 @@ bool AutosaveManager::setSlot(std::string_view name)
 {
 	if(autoSaveSlot == name)
 		return true;
-	if(!save())
+	if(!save(SaveAutosaveMode::WaitForWrite))
 		return false;
 	if(name.size() && name != noAutosaveName)
 	{
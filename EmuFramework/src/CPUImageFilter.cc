@@ -0,0 +1,172 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/CPUImageFilter.hh>
+import imagine;
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+constexpr SystemLogger log{"CPUImageFilter"};
+constexpr int minRowsPerBand = 16;
+
+// Scale2x/Scale3x (AdvanceMAME), the edge columns clamp their neighbors,
+// the interior loops have no clamping so the compiler can vectorize them
+
+template <class T>
+struct Scale2xRows
+{
+	const T *rowB, *rowE, *rowH;
+	T *out0, *out1;
+
+	[[gnu::always_inline]] void pixel(int xD, int x, int xF)
+	{
+		T B = rowB[x], D = rowE[xD], E = rowE[x], F = rowE[xF], H = rowH[x];
+		bool edge = B != H && D != F;
+		out0[x * 2]     = edge && D == B ? D : E;
+		out0[x * 2 + 1] = edge && B == F ? F : E;
+		out1[x * 2]     = edge && D == H ? D : E;
+		out1[x * 2 + 1] = edge && H == F ? F : E;
+	}
+};
+
+template <class T>
+struct Scale3xRows
+{
+	const T *rowB, *rowE, *rowH;
+	T *out0, *out1, *out2;
+
+	[[gnu::always_inline]] void pixel(int xD, int x, int xF)
+	{
+		T A = rowB[xD], B = rowB[x], C = rowB[xF];
+		T D = rowE[xD], E = rowE[x], F = rowE[xF];
+		T G = rowH[xD], H = rowH[x], I = rowH[xF];
+		bool edge = B != H && D != F;
+		bool DB = edge && D == B, BF = edge && B == F;
+		bool DH = edge && D == H, HF = edge && H == F;
+		out0[x * 3]     = DB ? D : E;
+		out0[x * 3 + 1] = (DB && E != C) || (BF && E != A) ? B : E;
+		out0[x * 3 + 2] = BF ? F : E;
+		out1[x * 3]     = (DB && E != G) || (DH && E != A) ? D : E;
+		out1[x * 3 + 1] = E;
+		out1[x * 3 + 2] = (BF && E != I) || (HF && E != C) ? F : E;
+		out2[x * 3]     = DH ? D : E;
+		out2[x * 3 + 1] = (DH && E != I) || (HF && E != G) ? H : E;
+		out2[x * 3 + 2] = HF ? F : E;
+	}
+};
+
+static void scaleRow(auto rows, int w)
+{
+	if(w == 1)
+	{
+		rows.pixel(0, 0, 0);
+		return;
+	}
+	rows.pixel(0, 0, 1);
+	for(int x = 1; x < w - 1; x++)
+	{
+		rows.pixel(x - 1, x, x + 1);
+	}
+	rows.pixel(w - 2, w - 1, w - 1);
+}
+
+template <class T>
+static void scale2x(MutablePixmapView dest, PixmapView src, int y1, int y2)
+{
+	auto s = src.mdspan<T>();
+	auto d = dest.mdspan<T>();
+	int h = src.h();
+	for(int y = y1; y < y2; y++)
+	{
+		scaleRow(Scale2xRows<T>{&s[std::max(y - 1, 0), 0], &s[y, 0], &s[std::min(y + 1, h - 1), 0],
+			&d[y * 2, 0], &d[y * 2 + 1, 0]}, src.w());
+	}
+}
+
+template <class T>
+static void scale3x(MutablePixmapView dest, PixmapView src, int y1, int y2)
+{
+	auto s = src.mdspan<T>();
+	auto d = dest.mdspan<T>();
+	int h = src.h();
+	for(int y = y1; y < y2; y++)
+	{
+		scaleRow(Scale3xRows<T>{&s[std::max(y - 1, 0), 0], &s[y, 0], &s[std::min(y + 1, h - 1), 0],
+			&d[y * 3, 0], &d[y * 3 + 1, 0], &d[y * 3 + 2, 0]}, src.w());
+	}
+}
+
+template <class T>
+static void runFilter(CPUImageFilterId id, MutablePixmapView dest, PixmapView src, int y1, int y2)
+{
+	switch(id)
+	{
+		case CPUImageFilterId::NONE: break;
+		case CPUImageFilterId::SCALE2X: return scale2x<T>(dest, src, y1, y2);
+		case CPUImageFilterId::SCALE3X: return scale3x<T>(dest, src, y1, y2);
+	}
+}
+
+void CPUImageFilter::setId(Id id)
+{
+	if(id == id_)
+		return;
+	id_ = id;
+	inputPix = {};
+}
+
+int CPUImageFilter::scale() const
+{
+	switch(id_)
+	{
+		case Id::NONE: return 1;
+		case Id::SCALE2X: return 2;
+		case Id::SCALE3X: return 3;
+	}
+	unreachable();
+}
+
+PixmapDesc CPUImageFilter::setInputFormat(PixmapDesc desc)
+{
+	if(inputPix.desc() != desc)
+	{
+		log.info("input format:{}x{} {}", desc.w(), desc.h(), desc.format.name());
+		inputPix = {desc};
+	}
+	return desc.makeNewSize(desc.size * scale());
+}
+
+void CPUImageFilter::run(ThreadPool &threadPool, MutablePixmapView dest, PixmapView src)
+{
+	assume(dest.format() == src.format());
+	assume(dest.size() == src.size() * scale());
+	int h = src.h();
+	int bands = std::clamp(h / minRowsPerBand, 1, threadPool.threads() + 1);
+	threadPool.parallelFor(bands, [&](int band)
+	{
+		int y1 = h * band / bands;
+		int y2 = h * (band + 1) / bands;
+		switch(src.format().bytesPerPixel())
+		{
+			case 2: return runFilter<uint16_t>(id_, dest, src, y1, y2);
+			case 4: return runFilter<uint32_t>(id_, dest, src, y1, y2);
+		}
+	});
+}
+
+}
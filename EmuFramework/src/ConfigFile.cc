@@ -55,6 +55,7 @@ void EmuApp::saveConfigFile(FileIO &io)
 	writeOptionValueIfNotDefault(io, frameClockSource);
 	writeOptionValueIfNotDefault(io, idleDisplayPowerSave);
 	writeOptionValueIfNotDefault(io, confirmOverwriteState);
+	writeOptionValueIfNotDefault(io, saveStateFormat);
 	writeOptionValueIfNotDefault(io, systemActionsIsDefaultMenu);
 	writeOptionValueIfNotDefault(io, pauseUnfocused);
 	writeOptionValueIfNotDefault(io, emuOrientation);
@@ -100,6 +101,8 @@ void EmuApp::saveConfigFile(FileIO &io)
 		writeOptionValue(io, CFGKEY_BLUETOOTH_SCAN_CACHE, false);
 	writeOptionValueIfNotDefault(io, cpuAffinityMask);
 	writeOptionValueIfNotDefault(io, cpuAffinityMode);
+	writeOptionValueIfNotDefault(io, threadPlacement);
+	writeOptionValueIfNotDefault(io, threadPriority);
 	writeOptionValueIfNotDefault(io, presentMode);
 	if(emuWindow().supportsFrameClockSource(FrameClockSource::Screen))
 		writeOptionValueIfNotDefault(io, outputFrameRateMode);
@@ -111,6 +114,11 @@ void EmuApp::saveConfigFile(FileIO &io)
 	inputManager.writeSavedInputDevices(appContext(), io);
 	writeOptionValueIfNotDefault(io, showFrameTimingStats);
 	writeOptionValueIfNotDefault(io, lowLatencyVideo);
+	writeOptionValueIfNotDefault(io, tripleBufferVideo);
+	writeOptionValueIfNotDefault(io, runAheadFrames);
+	writeOptionValueIfNotDefault(io, lateStartMarginMSecs);
+	writeOptionValueIfNotDefault(io, guestMemoryHugePages);
+	writeOptionValueIfNotDefault(io, lockGuestMemory);
 }
 
 EmuApp::ConfigParams EmuApp::loadConfigFile(ApplicationContext ctx)
@@ -171,6 +179,8 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(ApplicationContext ctx)
 				}
 				case CFGKEY_RECENT_CONTENT_V2:
 					return AppMeta::handlesRecentContent ? system().readConfig(ConfigType::MAIN, io, key) : recentContent.readContent(io, system());
+				case CFGKEY_RECENT_CONTENT_ARCHIVE_ENTRY:
+					return AppMeta::handlesRecentContent ? false : recentContent.readArchiveEntry(io);
 				case CFGKEY_FRAME_INTERVAL: return readOptionValue(io, frameInterval);
 				case CFGKEY_FRAME_RATE: return readOptionValue<FrameDuration>(io, [&](auto &&val){outputTimingManager.setFrameRateOption(VideoSystem::NATIVE_NTSC, val);});
 				case CFGKEY_FRAME_RATE_PAL: return readOptionValue<FrameDuration>(io, [&](auto &&val){outputTimingManager.setFrameRateOption(VideoSystem::PAL, val);});
@@ -196,6 +206,7 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(ApplicationContext ctx)
 				case CFGKEY_LAYOUT_BEHIND_SYSTEM_UI:
 					return ctx.hasTranslucentSysUI() ? readOptionValue(io, layoutBehindSystemUI) : false;
 				case CFGKEY_CONFIRM_OVERWRITE_STATE: return readOptionValue(io, confirmOverwriteState);
+				case CFGKEY_SAVE_STATE_FORMAT: return readOptionValue(io, saveStateFormat);
 				case CFGKEY_FAST_MODE_SPEED: return readOptionValue(io, fastModeSpeed);
 				case CFGKEY_SLOW_MODE_SPEED: return readOptionValue(io, slowModeSpeed);
 				case CFGKEY_NOTIFY_INPUT_DEVICE_CHANGE: return readOptionValue(io, notifyOnInputDeviceChange);
@@ -212,6 +223,8 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(ApplicationContext ctx)
 					&& readOptionValue<bool>(io, [this](auto on){ bluetoothAdapter.useScanCache = on; });
 				case CFGKEY_CPU_AFFINITY_MASK: return readOptionValue(io, cpuAffinityMask);
 				case CFGKEY_CPU_AFFINITY_MODE: return readOptionValue(io, cpuAffinityMode);
+				case CFGKEY_THREAD_PLACEMENT: return readOptionValue(io, threadPlacement);
+				case CFGKEY_THREAD_PRIORITY: return readOptionValue(io, threadPriority);
 				case CFGKEY_RENDERER_PRESENT_MODE: return readOptionValue(io, presentMode);
 				case CFGKEY_OUTPUT_FRAME_RATE_MODE: return readOptionValue(io, outputFrameRateMode);
 				case CFGKEY_FRAME_CLOCK: return readOptionValue(io, frameClockSource);
@@ -236,6 +249,11 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(ApplicationContext ctx)
 				case CFGKEY_INPUT_DEVICE_CONFIGS: return inputManager.readSavedInputDevices(io);
 				case CFGKEY_SHOW_FRAME_TIMING_STATS: return readOptionValue(io, showFrameTimingStats);
 				case CFGKEY_LOW_LATENCY_VIDEO: return readOptionValue(io, lowLatencyVideo);
+				case CFGKEY_TRIPLE_BUFFER_VIDEO: return readOptionValue(io, tripleBufferVideo);
+				case CFGKEY_RUN_AHEAD_FRAMES: return readOptionValue(io, runAheadFrames);
+				case CFGKEY_LATE_START_MARGIN: return readOptionValue(io, lateStartMarginMSecs);
+				case CFGKEY_GUEST_MEMORY_HUGE_PAGES: return readOptionValue(io, guestMemoryHugePages);
+				case CFGKEY_LOCK_GUEST_MEMORY: return readOptionValue(io, lockGuestMemory);
 			}
 			return false;
 		});
@@ -39,12 +39,14 @@ using namespace IG;
 constexpr SystemLogger log{"App"};
 static EmuApp *gAppPtr{};
 constexpr float pausedVideoBrightnessScale = .75f;
+constexpr int maxThreadPoolThreads = 4;
 
 EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	Application{initParams},
 	fontManager{ctx},
 	renderer{ctx},
 	audio{ctx},
+	video{ctx},
 	videoLayer{video, defaultVideoAspectRatio()},
 	inputManager{ctx},
 	assetManager{ctx},
@@ -119,6 +121,19 @@ const Screen &EmuApp::emuScreen() const { return *viewController().emuWindowScre
 Window &EmuApp::emuWindow() { return viewController().emuWindow(); }
 const Window &EmuApp::emuWindow() const { return viewController().emuWindow(); }
 
+ThreadPool &EmuApp::threadPool()
+{
+	if(!threadPoolStarted) [[unlikely]]
+	{
+		threadPoolStarted = true;
+		auto ctx = appContext();
+		// leave a core each for the emulation and renderer threads, callers also run jobs while waiting
+		threadPool_.start({.threads = std::clamp(ctx.cpuCount() - 2, 0, maxThreadPoolThreads),
+			.cpuMask = ctx.cpuMask(CPUCoreType::Performance)});
+	}
+	return threadPool_;
+}
+
 void EmuApp::setCPUNeedsLowLatency(ApplicationContext ctx, bool needed)
 {
 	#ifdef __ANDROID__
@@ -143,6 +158,7 @@ void EmuApp::closeSystem()
 	systemTask.stop();
 	showUI();
 	system().closeRuntimeSystem(*this);
+	stateWriter.flush();
 	autosaveManager.resetSlot();
 	rewindManager.clear();
 	viewController().onSystemClosed();
@@ -189,13 +205,28 @@ void EmuApp::showExitAlert(ViewAttachParams attach, const Input::Event &e)
 		attach, system().hasContent()), e, false);
 }
 
-static const char *parseCommandArgs(CommandArgs arg)
+static const char *parseCommandArgs(CommandArgs arg, int &benchmarkFrames)
 {
-	if(arg.c < 2)
+	int pathIdx = 1;
+	if(arg.c >= 2 && std::string_view{arg.v[1]}.starts_with("--benchmark"))
 	{
+		// --benchmark[=frames] <content path>
+		std::string_view optStr{arg.v[1]};
+		benchmarkFrames = defaultBenchmarkFrames;
+		if(auto eqPos = optStr.find('='); eqPos != std::string_view::npos)
+		{
+			auto frames = std::strtol(arg.v[1] + eqPos + 1, nullptr, 10);
+			if(frames > 0)
+				benchmarkFrames = frames;
+		}
+		pathIdx++;
+	}
+	if(arg.c <= pathIdx)
+	{
+		benchmarkFrames = 0;
 		return nullptr;
 	}
-	auto launchPath = arg.v[1];
+	auto launchPath = arg.v[pathIdx];
 	log.info("starting content from command line:{}", launchPath);
 	return launchPath;
 }
@@ -301,7 +332,7 @@ void EmuApp::mainInitCommon(ApplicationInitParams initParams, ApplicationContext
 	system().onOptionsLoaded();
 	loadSystemOptions();
 	updateLegacySavePathOnStoragePath(ctx, system());
-	system().setInitialLoadPath(parseCommandArgs(initParams.commandArgs()));
+	system().setInitialLoadPath(parseCommandArgs(initParams.commandArgs(), benchmarkFrames));
 	audio.manager.setMusicVolumeControlHint();
 	if(!renderer.supportsColorSpace())
 		windowDrawableConfig.colorSpace = {};
@@ -327,6 +358,7 @@ void EmuApp::mainInitCommon(ApplicationInitParams initParams, ApplicationContext
 					ctx.addNotification(title, title, system().contentDisplayName());
 				}
 			}
+			stateWriter.flush();
 			audio.close();
 			audio.manager.endSession();
 			saveConfigFile(ctx);
@@ -337,6 +369,12 @@ void EmuApp::mainInitCommon(ApplicationInitParams initParams, ApplicationContext
 			return true;
 		});
 
+	if(benchmarkFrames)
+	{
+		runBenchmarkFromCommandLine(system().contentLocation());
+		return;
+	}
+
 	WindowConfig winConf{ .title = ApplicationMeta::name };
 	winConf.setFormat(windowDrawableConfig.pixelFormat);
 	ctx.makeWindow(winConf,
@@ -624,15 +662,69 @@ void EmuApp::handleOpenFileCommand(CStringView path)
 	}
 }
 
-void EmuApp::runBenchmarkOneShot(EmuVideo &video)
+BenchmarkResult EmuApp::runBenchmarkOneShot(EmuVideo &video, int frames)
 {
 	log.info("starting benchmark");
-	auto time = system().benchmark(video);
+	auto result = system().benchmark(&video, frames);
 	autosaveManager.resetSlot(noAutosaveName);
 	closeSystem();
-	auto timeSecs = duration_cast<FloatSeconds>(time);
-	log.info("done in:{}", timeSecs);
-	postMessage(2, 0, std::format("{:.2f} fps", 180. / timeSecs.count()));
+	log.info("done in:{} median frame:{} p99 frame:{} frame hash:{:016x} state hash:{:016x}",
+		duration_cast<FloatSeconds>(result.totalTime), duration_cast<Microseconds>(result.medianFrameTime),
+		duration_cast<Microseconds>(result.p99FrameTime), result.frameHash, result.stateHash);
+	postMessage(2, 0, std::format("{:.2f} fps", result.framesPerSecond()));
+	return result;
+}
+
+void EmuApp::runBenchmarkFromCommandLine(CStringView path)
+{
+	// runs before any window or renderer exists, the video has no renderer task
+	// so frames are only kept in a CPU buffer for hashing
+	auto ctx = appContext();
+	log.info("running {} frame benchmark of {} from command line", benchmarkFrames, path);
+	bool useRGB565 = !AppMeta::canRenderRGBA8888 || (AppMeta::canRenderRGB565 && renderPixelFormat.value() == PixelFmtRGB565);
+	video.setRenderPixelFormat(system(), useRGB565 ? PixelFmtRGB565 : PixelFmtRGBA8888, Gfx::ColorSpace::LINEAR);
+	system().guestMemoryFlags = {.hugePages = guestMemoryHugePages, .locked = lockGuestMemory};
+	try
+	{
+		system().createWithMedia({}, path, ctx.fileUriDisplayName(path), {}, [](int, int, const char*){ return true; });
+	}
+	catch(std::exception &err)
+	{
+		log.error("error loading benchmark content:{}", err.what());
+		ctx.exit(1);
+		return;
+	}
+	auto result = system().benchmark(&video, benchmarkFrames);
+	autosaveManager.resetSlot(noAutosaveName);
+	system().closeRuntimeSystem(*this);
+	auto report = std::format("frames:{} fps:{:.2f} median:{:.3f}ms p99:{:.3f}ms frame hash:{:016x} state hash:{:016x}",
+		result.frames, result.framesPerSecond(),
+		duration_cast<FloatSeconds>(result.medianFrameTime).count() * 1000.,
+		duration_cast<FloatSeconds>(result.p99FrameTime).count() * 1000.,
+		result.frameHash, result.stateHash);
+	if(result.tlbMisses)
+	{
+		// compare runs with the guest memory options toggled to see the effect of huge pages
+		std::format_to(std::back_inserter(report), " dTLB misses:{} ({:.1f}/frame) huge pages:{} locked:{}",
+			*result.tlbMisses, double(*result.tlbMisses) / result.frames,
+			(bool)guestMemoryHugePages, (bool)lockGuestMemory);
+	}
+	log.info("benchmark result {}", report);
+	// logging is off by default in release builds, so also keep the result in a file
+	auto dir = FS::createDirectorySegments(ctx.storagePath(), "EmuEx", "benchmarks");
+	auto resultPath = FS::pathString(dir, ctx.formatDateAndTimeAsFilename(WallClock::now()).append(".txt"));
+	try
+	{
+		report += '\n';
+		FileIO file{resultPath, OpenFlags::newFile()};
+		file.write(report.data(), report.size());
+		log.info("wrote benchmark result to:{}", resultPath);
+	}
+	catch(std::exception &err)
+	{
+		log.error("error writing benchmark result:{}", err.what());
+	}
+	ctx.exit();
 }
 
 void EmuApp::showEmulation()
@@ -783,6 +875,9 @@ void EmuApp::createSystemWithMedia(IO io, CStringView path, std::string_view dis
 		return;
 	}
 	closeSystem();
+	if(!params.archiveEntry)
+		params.archiveEntry = recentContent.archiveEntry(path);
+	system().guestMemoryFlags = {.hugePages = guestMemoryHugePages, .locked = lockGuestMemory};
 	auto loadProgressView = std::make_unique<LoadProgressView>(attachParams, e, onComplete);
 	auto &msgPort = loadProgressView->messagePort();
 	pushAndShowModalView(std::move(loadProgressView), e);
@@ -848,10 +943,10 @@ void EmuApp::setupStaticBackupMemoryFile(FileIO &io, std::string_view ext, size_
 		throw std::runtime_error(std::format("Error opening {}, please verify save path has write access", system().contentNameExt(ext)));
 }
 
-void EmuApp::readState(std::span<uint8_t> buff)
+void EmuApp::readState(FileIO &io)
 {
 	auto suspendCtx = suspendEmulationThread();
-	system().readState(*this, buff);
+	system().loadState(*this, io);
 	system().clearInputBuffers();
 	autosaveManager.resetTimer();
 }
@@ -862,10 +957,12 @@ size_t EmuApp::writeState(std::span<uint8_t> buff, SaveStateFlags flags)
 	return system().writeState(buff, flags);
 }
 
-DynArray<uint8_t> EmuApp::saveState()
+void EmuApp::setRewindMemory(uint16_t mib)
 {
+	// the emulation thread captures into the rewind buffers, so they can't be reallocated under it
 	auto suspendCtx = suspendEmulationThread();
-	return system().saveState();
+	if(!rewindManager.updateMaxMemory(mib))
+		postErrorMessage(4, "Not enough memory for rewind states");
 }
 
 bool EmuApp::saveState(CStringView path, bool notify)
@@ -879,9 +976,7 @@ bool EmuApp::saveState(CStringView path, bool notify)
 	auto suspendCtx = suspendEmulationThread();
 	try
 	{
-		system().saveState(path);
-		if(notify)
-			postMessage("State Saved");
+		stateWriter.write(system(), path, notify);
 		return true;
 	}
 	catch(std::exception &err)
@@ -972,6 +1067,7 @@ void EmuApp::setRunSpeed(double speed)
 	assume(speed > 0.);
 	auto _ = suspendEmulationThread();
 	system().frameRateMultiplier = speed;
+	system().onSpeedMultiplierChanged(speed);
 	audio.setSpeedMultiplier(speed);
 	systemTask.updateSystemFrameRate();
 }
@@ -1281,6 +1377,14 @@ void EmuApp::configureSecondaryScreens()
 
 void EmuApp::record(FrameTimingStatEvent event, SteadyClockTimePoint t)
 {
+	if(frameTimingTrace.isEnabled()) [[unlikely]]
+	{
+		if(!hasTime(t))
+			t = SteadyClock::now();
+		frameTimingTrace.record(event, t);
+		if(event == FrameTimingStatEvent::endOfFrame)
+			frameTimingTrace.commitFrame(audio.framesWritten());
+	}
 	if(!viewController().emuView.showingFrameTimingStats())
 			return;
 	auto setTime = [](auto& var, SteadyClockTimePoint t)
@@ -1299,6 +1403,29 @@ void EmuApp::record(FrameTimingStatEvent event, SteadyClockTimePoint t)
 	std::unreachable();
 }
 
+void EmuApp::exportFrameTimingTrace()
+{
+	if(!frameTimingTrace.recordedFrames())
+	{
+		postErrorMessage("No frames recorded yet");
+		return;
+	}
+	auto dir = FS::createDirectorySegments(appContext().storagePath(), "EmuEx", "traces");
+	auto path = FS::pathString(dir, appContext().formatDateAndTimeAsFilename(WallClock::now()).append(".json"));
+	try
+	{
+		auto json = frameTimingTrace.chromeTraceJson();
+		FileIO file{path, OpenFlags::newFile()};
+		file.write(json.data(), json.size());
+		log.info("wrote {} frame timing trace to:{}", frameTimingTrace.recordedFrames(), path);
+		postMessage(std::format("Wrote {} frames to:\n{}", frameTimingTrace.recordedFrames(), path));
+	}
+	catch(std::exception &err)
+	{
+		postErrorMessage(std::format("Error writing trace:\n{}", err.what()));
+	}
+}
+
 bool EmuApp::setAltSpeed(AltSpeedMode mode, int16_t speed)
 {
 	if(mode == AltSpeedMode::slow)
@@ -1309,10 +1436,25 @@ bool EmuApp::setAltSpeed(AltSpeedMode mode, int16_t speed)
 
 void EmuApp::applyCPUAffinity(bool active)
 {
-	if(cpuAffinityMode.value() == CPUAffinityMode::Any)
-		return;
 	auto frameThreadGroup = std::vector{systemTask.threadId(), renderer.task().threadId()};
 	system().addThreadGroupIds(frameThreadGroup);
+	std::erase(frameThreadGroup, ThreadId{}); // an ID of 0 would apply to the calling thread
+	applyThreadPriority(frameThreadGroup, active);
+	// roles with a set placement override the affinity mode
+	for(auto i : iotaCount(enumCount<ThreadRole>))
+	{
+		auto role = ThreadRole(i);
+		auto placement = threadPlacement.value()[role];
+		if(placement == ThreadPlacement::Default)
+			continue;
+		auto mask = active ? threadPlacementMask(placement) : 0;
+		if(role == ThreadRole::Audio)
+			audio.setCallbackThreadCPUAffinityMask(mask);
+		else
+			setThreadCPUAffinityMask(threadIds(role), mask);
+	}
+	if(cpuAffinityMode.value() == CPUAffinityMode::Any)
+		return;
 	if(cpuAffinityMode.value() == CPUAffinityMode::Auto && perfHintManager)
 	{
 		if(active)
@@ -1334,7 +1476,70 @@ void EmuApp::applyCPUAffinity(bool active)
 	auto mask = active ?
 		(cpuAffinityMode.value() == CPUAffinityMode::Auto ? appContext().performanceCPUMask() : cpuAffinityMask.value()) : 0;
 	log.info("applying CPU affinity mask {:X}", mask);
-	setThreadCPUAffinityMask(frameThreadGroup, mask);
+	std::vector<ThreadId> defaultPlacedIds;
+	for(auto role : {ThreadRole::Emulation, ThreadRole::Renderer, ThreadRole::CoreHelper})
+	{
+		if(threadPlacement.value()[role] == ThreadPlacement::Default)
+			std::ranges::copy(threadIds(role), std::back_inserter(defaultPlacedIds));
+	}
+	setThreadCPUAffinityMask(defaultPlacedIds, mask);
+}
+
+void EmuApp::applyThreadPriority(std::span<const ThreadId> ids, bool active)
+{
+	constexpr int highPriorityNice = -10;
+	constexpr int realtimePriority = 1; // lowest SCHED_FIFO level so audio servers can still preempt
+	auto priority = active ? threadPriority.value() : ThreadPriority::Normal;
+	if(priority == appliedThreadPriority)
+		return;
+	auto resetRealtimePriority = [&]
+	{
+		for(auto id : ids)
+			setThreadRealtimePriority(id, 0);
+	};
+	if(appliedThreadPriority == ThreadPriority::Realtime)
+		resetRealtimePriority();
+	if(priority == ThreadPriority::Realtime)
+	{
+		log.info("using real-time scheduling for frame threads");
+		if(std::ranges::all_of(ids, [&](auto id) { return setThreadRealtimePriority(id, realtimePriority); }))
+		{
+			appliedThreadPriority = priority;
+			return;
+		}
+		resetRealtimePriority();
+		log.warn("real-time scheduling not permitted, using high priority instead");
+		priority = ThreadPriority::High;
+	}
+	auto nice = priority == ThreadPriority::High ? highPriorityNice : 0;
+	for(auto id : ids)
+		setThreadPriority(id, nice);
+	appliedThreadPriority = priority;
+}
+
+std::vector<ThreadId> EmuApp::threadIds(ThreadRole role) const
+{
+	std::vector<ThreadId> ids;
+	switch(role)
+	{
+		case ThreadRole::Emulation: ids.emplace_back(systemTask.threadId()); break;
+		case ThreadRole::Renderer: ids.emplace_back(renderer.task().threadId()); break;
+		case ThreadRole::CoreHelper: system().addThreadGroupIds(ids); break;
+		case ThreadRole::Audio: ids.emplace_back(audio.callbackThreadId()); break;
+		case ThreadRole::IO: system().addIOThreadIds(ids); break;
+	}
+	std::erase(ids, ThreadId{}); // skip threads that aren't running
+	return ids;
+}
+
+CPUMask EmuApp::threadPlacementMask(ThreadPlacement placement) const
+{
+	switch(placement)
+	{
+		case ThreadPlacement::Performance: return appContext().cpuMask(CPUCoreType::Performance);
+		case ThreadPlacement::Efficiency: return appContext().cpuMask(CPUCoreType::Efficiency);
+		default: return 0;
+	}
 }
 
 void EmuApp::setCPUAffinity(int cpuNumber, bool on)
@@ -1356,6 +1561,12 @@ void EmuApp::setLowLatencyVideo(bool on)
 	video.resetImage();
 }
 
+void EmuApp::setTripleBufferVideo(bool on)
+{
+	tripleBufferVideo = on;
+	video.resetImage();
+}
+
 std::unique_ptr<View> EmuApp::makeView(ViewAttachParams attach, ViewID id)
 {
 	auto view = makeCustomView(attach, id);
@@ -24,6 +24,12 @@ namespace EmuEx
 using namespace IG;
 
 constexpr SystemLogger log{"EmuAudio"};
+// dynamic rate control, the output rate is adjusted by at most this fraction to steer the buffer fill
+constexpr double maxRateCorrection = .005;
+constexpr double rateProportionalGain = .005;
+constexpr double rateIntegralGain = .00005;
+constexpr double fillSmoothing = .1;
+constexpr Seconds bufferDecreaseDelay{10};
 
 #ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 static AudioStats audioStats{};
@@ -80,6 +86,27 @@ bool EmuAudio::shouldStartAudioWrites(size_t bytesToWrite) const
 	return rBuff.size() + bytesToWrite >= targetBufferFillBytes;
 }
 
+void EmuAudio::updateRateCorrection(size_t inputFrames)
+{
+	if(audioWriteState != AudioWriteState::ACTIVE || speedMultiplier != 1. || !targetBufferFillBytes)
+	{
+		smoothedFillBytes = targetBufferFillBytes;
+		rateCorrection_ = 1.;
+		return;
+	}
+	// after a temporary buffer increase, step the target back down no faster than the rate correction can drain it
+	if(targetBufferFillBytes > baseBufferFillBytes && SteadyClock::now() - lastBufferIncreaseTime > bufferDecreaseDelay)
+	{
+		auto stepBytes = format().framesToBytes(std::max(size_t(inputFrames * maxRateCorrection), 1zu));
+		targetBufferFillBytes -= std::min(stepBytes, targetBufferFillBytes - baseBufferFillBytes);
+	}
+	// PI controller on the low-passed fill level, the integral term absorbs any constant clock mismatch
+	smoothedFillBytes += (double(rBuff.size()) - smoothedFillBytes) * fillSmoothing;
+	auto fillError = (smoothedFillBytes - targetBufferFillBytes) / targetBufferFillBytes;
+	fillErrorIntegral = std::clamp(fillErrorIntegral + fillError * rateIntegralGain, -maxRateCorrection, maxRateCorrection);
+	rateCorrection_ = 1. + std::clamp(fillError * rateProportionalGain + fillErrorIntegral, -maxRateCorrection, maxRateCorrection);
+}
+
 template<typename T>
 static void simpleResample(T * __restrict__ dest, size_t destFrames, const T * __restrict__ src, size_t srcFrames)
 {
@@ -117,6 +144,14 @@ static void simpleResample(void *dest, size_t destFrames, const void *src, size_
 	}
 }
 
+size_t EmuAudio::resample(void *dest, size_t destFrames, const void *src, size_t srcFrames, double ratio)
+{
+	if(resamplerType == AudioResamplerType::sinc)
+		return sincResampler.resample(dest, destFrames, src, srcFrames, format(), ratio);
+	simpleResample(dest, destFrames, src, srcFrames, format());
+	return destFrames;
+}
+
 void EmuAudio::resizeAudioBuffer(size_t targetBufferFillBytes)
 {
 	auto oldCapacity = rBuff.capacity();
@@ -146,7 +181,10 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 	}
 	lastUnderrunTime = {};
 	auto inputFormat = format();
-	targetBufferFillBytes = inputFormat.timeToBytes(targetBufferFillDuration);
+	targetBufferFillBytes = baseBufferFillBytes = inputFormat.timeToBytes(targetBufferFillDuration);
+	smoothedFillBytes = targetBufferFillBytes;
+	fillErrorIntegral = 0;
+	rateCorrection_ = 1.;
 	bufferIncrementBytes = inputFormat.timeToBytes(bufferDuration);
 	if(!audioStream.isOpen())
 	{
@@ -159,6 +197,8 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 			[this, outputSampleFormat = outputFormat.sample, inputSampleFormat = inputFormat.sample, channels = outputFormat.channels](void *samples, size_t frames)
 			{
 				Audio::Format outputFormat{{}, outputSampleFormat, channels};
+				if(callbackThreadNeedsSetup.load(std::memory_order::relaxed)) [[unlikely]]
+					setupCallbackThread();
 				#ifdef CONFIG_EMUFRAMEWORK_AUDIO_STATS
 				audioStats.callbacks++;
 				audioStats.callbackBytes += bytes;
@@ -200,6 +240,9 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 			}
 		};
 		outputConf.wantedLatencyHint = {};
+		// the stream may call back on a new thread
+		callbackThreadId_.store({}, std::memory_order::relaxed);
+		callbackThreadNeedsSetup.store(true, std::memory_order::relaxed);
 		startAudioStats(inputFormat);
 		audioStream.open(outputConf);
 	}
@@ -220,6 +263,23 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 	}
 }
 
+void EmuAudio::setCallbackThreadCPUAffinityMask(CPUMask mask)
+{
+	hasCallbackThreadCPUMask = true;
+	callbackThreadCPUMask.store(mask, std::memory_order::relaxed);
+	callbackThreadNeedsSetup.store(true, std::memory_order::release);
+}
+
+void EmuAudio::setupCallbackThread()
+{
+	if(!callbackThreadNeedsSetup.exchange(false, std::memory_order::acquire))
+		return;
+	auto id = thisThreadId();
+	callbackThreadId_.store(id, std::memory_order::relaxed);
+	if(hasCallbackThreadCPUMask)
+		setThreadCPUAffinityMask({&id, 1}, callbackThreadCPUMask.load(std::memory_order::relaxed));
+}
+
 void EmuAudio::stop()
 {
 	stopAudioStats();
@@ -227,6 +287,7 @@ void EmuAudio::stop()
 	if(audioStream)
 		audioStream.close();
 	rBuff.clear();
+	sincResampler.reset();
 }
 
 void EmuAudio::close()
@@ -245,9 +306,10 @@ void EmuAudio::flush()
 	if(audioStream)
 		audioStream.flush();
 	rBuff.clear();
+	sincResampler.reset();
 }
 
-void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
+void EmuAudio::writeFrames(const void *samples, size_t framesToWrite, AudioWriteParams params)
 {
 	if(!framesToWrite) [[unlikely]]
 		return;
@@ -259,9 +321,10 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 			if(speedMultiplier == 1. && addSoundBuffersOnUnderrun &&
 				inputFormat.bytesToTime(rBuff.capacity()).count() <= 1.) // hard cap buffer increase to 1 sec
 			{
-				log.warn("increasing buffer size due to multiple underruns within a short time");
+				log.warn("temporarily increasing buffer size due to multiple underruns within a short time");
 				targetBufferFillBytes += bufferIncrementBytes;
 				resizeAudioBuffer(targetBufferFillBytes);
+				lastBufferIncreaseTime = SteadyClock::now();
 			}
 			[[fallthrough]];
 		case AudioWriteState::UNDERRUN:
@@ -271,19 +334,32 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 		break;
 	}
 	const size_t sampleFrames = framesToWrite;
-	if(speedMultiplier != 1.) [[unlikely]]
+	updateRateCorrection(sampleFrames);
+	const auto ratio = (params.speedAdjusted ? 1. : speedMultiplier) * rateCorrection_;
+	// keep running the sinc filter once started so its delay line stays continuous
+	bool needsResample = ratio != 1. || sincResampler.isActive();
+	if(needsResample)
 	{
-		framesToWrite = std::ceil((double)framesToWrite / speedMultiplier);
-		framesToWrite = std::max(framesToWrite, 1zu);
+		if(resamplerType == AudioResamplerType::sinc)
+		{
+			framesToWrite = SincResampler::maxOutputFrames(sampleFrames, ratio);
+		}
+		else
+		{
+			auto exactFrames = sampleFrames / ratio + nearestFramesRemainder;
+			framesToWrite = std::max(size_t(exactFrames), 1zu);
+			nearestFramesRemainder = std::max(exactFrames - framesToWrite, 0.);
+		}
 	}
 	auto bytes = inputFormat.framesToBytes(framesToWrite);
 	{
 		auto span = rBuff.beginWrite(bytes);
 		if(bytes <= span.size())
 		{
-			if(sampleFrames != framesToWrite)
+			if(needsResample)
 			{
-				simpleResample(span.data(), framesToWrite, samples, sampleFrames, inputFormat);
+				auto framesWritten = resample(span.data(), framesToWrite, samples, sampleFrames, ratio);
+				span = {span.first(inputFormat.framesToBytes(framesWritten)), span.idxs};
 			}
 			else
 			{
@@ -298,6 +374,7 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 			#endif
 			auto freeFrames = inputFormat.bytesToFrames(span.size());
 			simpleResample(span.data(), freeFrames, samples, sampleFrames, inputFormat);
+			sincResampler.reset();
 		}
 		rBuff.endWrite(span);
 	}
@@ -433,6 +510,7 @@ void EmuAudio::writeConfig(FileIO &io) const
 	if(!AppMeta::forcedSoundRate)
 		writeOptionValueIfNotDefault(io, CFGKEY_SOUND_RATE, rate_, defaultRate);
 	writeOptionValueIfNotDefault(io, soundBuffers);
+	writeOptionValueIfNotDefault(io, resamplerType);
 	writeOptionValueIfNotDefault(io, CFGKEY_SOUND_VOLUME, maxVolume(), 100);
 	writeOptionValueIfNotDefault(io, CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN, addSoundBuffersOnUnderrunSetting, false);
 	writeOptionValueIfNotDefault(io, CFGKEY_AUDIO_API, audioAPI, Audio::Api::DEFAULT);
@@ -445,6 +523,7 @@ bool EmuAudio::readConfig(MapIO &io, unsigned key)
 		case CFGKEY_SOUND: return readOptionValue(io, flags);
 		case CFGKEY_SOUND_RATE: return AppMeta::forcedSoundRate ? false : readOptionValue(io, rate_, isValidSoundRate);
 		case CFGKEY_SOUND_BUFFERS: return readOptionValue(io, soundBuffers);
+		case CFGKEY_AUDIO_FRAMEWORK_RESAMPLER: return readOptionValue(io, resamplerType);
 		case CFGKEY_SOUND_VOLUME: return readOptionValue<int8_t>(io, [&](auto v){ setMaxVolume(v); }, isValidVolumeSetting);
 		case CFGKEY_ADD_SOUND_BUFFERS_ON_UNDERRUN: return readOptionValue(io, addSoundBuffersOnUnderrunSetting);
 		case CFGKEY_AUDIO_API: return readOptionValue(io, audioAPI);
@@ -184,9 +184,7 @@ bool InputManager::handleAppActionKeyInput(EmuApp& app, InputAction action, cons
 		break;
 		case rewind:
 		{
-			if(!isPushed)
-				break;
-			app.rewindManager.rewindState(app);
+			app.rewindManager.setRewinding(isPushed);
 		}
 		break;
 		case softReset:
@@ -667,7 +665,7 @@ std::string_view toString(AppKeyCode code)
 		case AppKeyCode::exitApp: return "Exit App";
 		case AppKeyCode::slowMotion: return "Slow-motion";
 		case AppKeyCode::toggleSlowMotion: return "Toggle Slow-motion";
-		case AppKeyCode::rewind: return "Rewind One State";
+		case AppKeyCode::rewind: return "Rewind";
 		case AppKeyCode::softReset: return "Soft Reset";
 		case AppKeyCode::hardReset: return "Hard Reset";
 		case AppKeyCode::resetMenu: return "Open Reset Menu";
@@ -15,6 +15,12 @@
 
 #include <emuframework/EmuSystem.hh>
 #include <emuframework/EmuApp.hh>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 import pathUtils;
 import imagine;
 
@@ -24,6 +30,7 @@ namespace EmuEx
 using namespace IG;
 
 constexpr SystemLogger log{"EmuSystem"};
+constexpr size_t maxExtractedArchiveEntrySize = 64 * 1024 * 1024;
 
 bool EmuSystem::stateExists(int slot) const
 {
@@ -45,13 +52,18 @@ bool EmuApp::shouldOverwriteExistingState() const
 void EmuSystem::loadState(EmuApp &app, CStringView uri)
 {
 	auto file = appContext().openFileUri(uri, {.accessHint = IOAccessHint::All});
-	readState(app, file.buffer(IOBufferMode::Release));
+	loadState(app, file);
 }
 
-void EmuSystem::saveState(CStringView uri)
+void EmuSystem::loadState(EmuApp &app, FileIO &io)
 {
-	auto file = appContext().openFileUri(uri, OpenFlags::newFile());
-	file.write(saveState().span());
+	app.stateWriter.flush();
+	// states never decode larger than what the core writes, allow some slack for older versions
+	auto state = readStateContainer(io, app.stateWriter.buffer(), app.stateWriter.scratchBuffer(), stateSize() * 2);
+	if(state.size())
+		readState(app, state);
+	else // legacy raw or gzip state
+		readState(app, io.buffer(IOBufferMode::Direct));
 }
 
 DynArray<uint8_t> EmuSystem::saveState()
@@ -154,6 +166,7 @@ void EmuSystem::clearGamePaths()
 	contentName_ = {};
 	contentDisplayName_ = {};
 	contentFileName_ = {};
+	contentArchiveEntry_ = {};
 	contentDirectory_ = {};
 	contentLocation_ = {};
 	contentSaveDirectory_ = {};
@@ -238,7 +251,8 @@ void EmuSystem::closeRuntimeSystem(EmuApp &app)
 	{
 		app.video.clear();
 		app.audio.flush();
-		app.autosaveManager.save();
+		// wait so a failed write is reported before the content is closed
+		app.autosaveManager.save(SaveAutosaveMode::WaitForWrite);
 		app.saveSessionOptions();
 		log.info("closing game:{}", contentName_);
 		flushBackupMemory(app);
@@ -266,7 +280,7 @@ void EmuSystem::pause(EmuApp &app)
 		state = State::PAUSED;
 	app.audio.stop();
 	app.autosaveManager.pauseTimer();
-	app.rewindManager.pauseTimer();
+	app.rewindManager.pause();
 	onStop();
 }
 
@@ -280,23 +294,79 @@ void EmuSystem::start(EmuApp &app)
 	onStart();
 	app.startAudio();
 	app.autosaveManager.startTimer();
-	if(AppMeta::stateSizeChangesAtRuntime && app.rewindManager.maxStates)
+	if(AppMeta::stateSizeChangesAtRuntime && app.rewindManager.isEnabled())
 	{
 		auto newStateSize = stateSize();
 		if(newStateSize != app.rewindManager.stateSize)
 			app.rewindManager.reset(newStateSize);
 	}
-	app.rewindManager.startTimer();
 }
 
-SteadyClockDuration EmuSystem::benchmark(EmuVideo& video)
+// Counts user-space data TLB misses of the calling thread when the kernel allows access to
+// the CPU's performance counters, used to compare guest memory flags in benchmarks
+class TLBMissCounter
 {
+public:
+	TLBMissCounter()
+	{
+		#ifdef __linux__
+		perf_event_attr attr{};
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HW_CACHE;
+		attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		fd = UniqueFileDescriptor{int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0))};
+		if(fd == -1)
+			log.info("TLB miss counter unavailable:{}", std::strerror(errno));
+		else
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+		#endif
+	}
+
+	std::optional<uint64_t> count() const
+	{
+		#ifdef __linux__
+		if(fd == -1)
+			return {};
+		ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+		uint64_t misses{};
+		if(::read(fd, &misses, sizeof(misses)) != sizeof(misses))
+			return {};
+		return misses;
+		#else
+		return {};
+		#endif
+	}
+
+private:
+	UniqueFileDescriptor fd;
+};
+
+BenchmarkResult EmuSystem::benchmark(EmuVideo *video, int frames)
+{
+	assume(frames > 0);
+	std::vector<SteadyClockDuration> frameTimes(frames);
+	TLBMissCounter tlbMissCounter;
 	auto before = SteadyClock::now();
-	for(auto _: iotaCount(180))
+	for(auto i : iotaCount(frames))
 	{
-		runFrame({}, &video, nullptr);
+		if(video && i == frames - 1)
+			video->requestFrameHash();
+		auto frameStart = SteadyClock::now();
+		runFrame({}, video, nullptr);
+		frameTimes[i] = SteadyClock::now() - frameStart;
 	}
-	return SteadyClock::now() - before;
+	BenchmarkResult result{.totalTime = SteadyClock::now() - before, .frames = frames, .tlbMisses = tlbMissCounter.count()};
+	std::ranges::sort(frameTimes);
+	result.medianFrameTime = frameTimes[frames / 2];
+	result.p99FrameTime = frameTimes[std::min(frames - 1, frames * 99 / 100)];
+	if(video)
+		result.frameHash = video->frameHash;
+	DynArray<uint8_t> state{stateSize()};
+	result.stateHash = fnv1aHash({state.data(), writeState(state, {.uncompressed = true})});
+	return result;
 }
 
 void EmuSystem::configFrameRate(int outputRate, FrameDuration outputFrameDuration)
@@ -389,33 +459,80 @@ void EmuSystem::loadContentFromPath(CStringView pathStr, std::string_view displa
 		path, displayName, params, onLoadProgress);
 }
 
-void EmuSystem::loadContentFromFile(IO file, CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
+static ArchiveIO findContentInArchive(IO file, const ArchiveEntryInfo &cachedEntry, ArchiveEntryInfo &foundEntry)
 {
-	if(!AppMeta::handlesArchiveFiles && EmuApp::hasArchiveExtension(displayName))
+	FS::ArchiveIterator it{std::move(file)};
+	if(cachedEntry)
 	{
-		IO io{};
-		FS::FileString originalName{};
-		for(auto &entry : FS::ArchiveIterator{std::move(file)})
+		// skip straight to the entry found on a previous load without checking names
+		uint32_t index{};
+		for(; it.hasEntry() && index < cachedEntry.index; ++it, index++) {}
+		if(it.hasEntry() && it->name() == cachedEntry.name && it->size() == cachedEntry.size && it->crc32() == cachedEntry.crc32)
 		{
-			if(entry.type() == FS::file_type::directory)
-			{
-				continue;
-			}
-			auto name = entry.name();
-			log.info("archive file entry:{}", name);
-			if(AppMeta::defaultFsFilter(name))
-			{
-				originalName = name;
-				io = std::move(entry);
-				break;
-			}
+			log.info("using cached archive entry:{} at index:{}", cachedEntry.name, index);
+			foundEntry = cachedEntry;
+			return std::move(*it);
+		}
+		log.info("cached archive entry:{} changed, scanning archive", cachedEntry.name);
+		it.rewind();
+	}
+	for(uint32_t index{}; it.hasEntry(); ++it, index++)
+	{
+		auto &entry = *it;
+		if(entry.type() == FS::file_type::directory)
+		{
+			continue;
+		}
+		auto name = entry.name();
+		log.info("archive file entry:{}", name);
+		if(AppMeta::defaultFsFilter(name))
+		{
+			foundEntry = {FS::FileString{name}, index, entry.crc32(), entry.size()};
+			return std::move(entry);
 		}
-		if(!io)
+	}
+	return {};
+}
+
+// Decompress the whole entry up front into page-mapped memory so the core gets
+// random access to it, reporting progress since large entries can take a while
+static IO extractArchiveEntry(ArchiveIO entry, EmuSystem::OnLoadProgressDelegate onLoadProgress)
+{
+	auto size = entry.size();
+	auto buff = vAlloc(size);
+	if(!buff.data())
+		return IO{std::move(entry)};
+	IOBuffer ioBuff{buff, {}, [](const uint8_t *ptr, size_t size) { vFree({const_cast<uint8_t*>(ptr), size}); }};
+	constexpr size_t chunkSize = 1024 * 1024;
+	int maxKiB = divRoundUp(size, 1024);
+	for(size_t offset = 0; offset < size;)
+	{
+		auto bytesRead = entry.read(buff.data() + offset, std::min(chunkSize, size - offset));
+		if(bytesRead <= 0)
+			throw std::runtime_error("Error extracting file from archive");
+		offset += bytesRead;
+		if(onLoadProgress)
+			onLoadProgress(offset / 1024, maxKiB, "Extracting...");
+	}
+	return IO{std::move(ioBuff)};
+}
+
+void EmuSystem::loadContentFromFile(IO file, CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
+{
+	if(!AppMeta::handlesArchiveFiles && EmuApp::hasArchiveExtension(displayName))
+	{
+		ArchiveEntryInfo entryInfo;
+		auto entry = findContentInArchive(std::move(file), params.archiveEntry, entryInfo);
+		if(!entry)
 		{
 			throw std::runtime_error("No recognized file extensions in archive");
 		}
+		IO io = entryInfo.size && entryInfo.size <= maxExtractedArchiveEntrySize &&
+			AppMeta::canExtractArchiveEntry(entryInfo.name, entryInfo.size) ?
+			extractArchiveEntry(std::move(entry), onLoadProgress) : IO{std::move(entry)};
 		closeAndSetupNew(path, displayName);
-		contentFileName_ = originalName;
+		contentFileName_ = entryInfo.name;
+		contentArchiveEntry_ = entryInfo;
 		loadContent(io, params, onLoadProgress);
 	}
 	else
@@ -568,6 +685,46 @@ FileIO EmuSystem::openStaticBackupMemoryFile(CStringView uri, size_t size, uint8
 	return file;
 }
 
+// Returns the whole content as memory the core can keep using after loading without
+// its own copy. Uncompressed files are mapped so pages are only read in when accessed,
+// other sources like streamed archive entries are read into memory. The buffer is taken
+// from the IO when possible, leaving it empty.
+MapIO EmuSystem::mapContent(IO &io, ContentMapFlags flags) const
+{
+	auto size = io.size();
+	if(!size) [[unlikely]]
+		return {};
+	if(auto mapIO = std::get_if<MapIO>(&io))
+	{
+		// extracted archive entries are already in private memory
+		if(!flags.copyOnWrite || !mapIO->isMappedFile())
+			return mapIO->releaseBuffer();
+		// a shared read-only mapping can't be made writable, map the file again from a new descriptor
+		if(!contentArchiveEntry_)
+		{
+			PosixIO file{appContext().openFileUriFd(contentLocation_, {.test = true})};
+			if(file && file.size() == size)
+			{
+				if(MapIO buff{file.mapRange(0, size, {.privateCopy = true})})
+					return buff;
+			}
+		}
+	}
+	else if(auto posixIO = std::get_if<PosixIO>(&io))
+	{
+		if(MapIO buff{posixIO->mapRange(0, size, {.privateCopy = flags.copyOnWrite})})
+			return buff;
+	}
+	log.info("copying {} bytes of content into memory", size);
+	auto buff = vAlloc(size);
+	if(!buff.data()) [[unlikely]]
+		throw std::bad_alloc();
+	IOBuffer ioBuff{buff, {}, [](const uint8_t *ptr, size_t size) { vFree({const_cast<uint8_t*>(ptr), size}); }};
+	if(io.read(buff.data(), size, 0) != ssize_t(size))
+		throwFileReadError();
+	return ioBuff;
+}
+
 void EmuSystem::runFrames(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio, int frames)
 {
 	skipFrames(taskCtx, frames - 1, audio);
@@ -45,7 +45,11 @@ void EmuSystemTask::start(Window& win)
 		return;
 	win.removeFrameEvents();
 	win.setDrawEventEnabled(false); // block UI from posting draws
-	shouldWaitForPresent = app.lowLatencyVideo && app.effectiveFrameClockSource() != FrameClockSource::Renderer;
+	// with a triple buffered image the renderer always picks up the newest frame so emulation never waits on it
+	shouldWaitForPresent = app.lowLatencyVideo && !app.video.image().usesMailbox() &&
+		app.effectiveFrameClockSource() != FrameClockSource::Renderer;
+	updateRunAheadState();
+	frameWorkPredictor.reset();
 	setWindowInternal(win);
 	taskThread = makeThreadSync(
 		[this](auto &sem)
@@ -88,6 +92,7 @@ void EmuSystemTask::start(Window& win)
 							window().removeFrameEvents();
 							threadId_ = 0;
 							frameRateConfig = {};
+							threadUsageStats = {};
 							EventLoop::forThread().stop();
 							return false;
 						},
@@ -433,14 +438,36 @@ bool EmuSystemTask::advanceFrames(FrameParams frameParams)
 		frameInfo.advanced = std::min(frameInfo.advanced, 4);
 	EmuVideo *videoPtr = savedAdvancedFrames ? nullptr : &app.video;
 	bool shouldWait{};
+	bool canDelayStart = videoPtr && frameInfo.advanced == 1 && !app.rewindManager.isRewinding();
 	if(videoPtr)
 	{
 		app.record(FrameTimingStatEvent::startOfFrame, frameParams.time);
+		if(canDelayStart)
+			delayFrameStart(frameParams);
 		app.record(FrameTimingStatEvent::startOfEmulation);
 		shouldWait = setWaitForPresent();
 	}
 	//log.debug("running {} frame(s), skip:{}", frameInfo.advanced, !videoPtr);
-	sys.runFrames({this}, videoPtr, audioPtr, frameInfo.advanced);
+	auto startEmulationTime = SteadyClock::now();
+	size_t runAheadStateSize{};
+	if(app.rewindManager.isRewinding()) [[unlikely]]
+	{
+		// step back through history, only running a frame to refresh the video output
+		if(app.rewindManager.rewindFrames(app, frameInfo.advanced))
+			sys.runFrames({this}, videoPtr, nullptr, 1);
+		else if(videoPtr)
+			videoPtr->startUnchangedFrame({this});
+	}
+	else
+	{
+		bool runAhead = videoPtr && runAheadState.size();
+		sys.runFrames({this}, runAhead ? nullptr : videoPtr, audioPtr, frameInfo.advanced);
+		app.rewindManager.captureFrames(sys, frameInfo.advanced);
+		if(runAhead)
+			runAheadStateSize = runFramesAhead(*videoPtr);
+	}
+	if(canDelayStart)
+		frameWorkPredictor.addDuration(SteadyClock::now() - startEmulationTime);
 	app.inputManager.turboActions.update(app);
 	if(!videoPtr)
 		return false;
@@ -449,14 +476,115 @@ bool EmuSystemTask::advanceFrames(FrameParams frameParams)
 	{
 		framePresentedSem.acquire();
 	}
+	if(runAheadStateSize)
+	{
+		// restored after presenting since the video texture may still be reading from the emulated frame buffer,
+		// if the present wasn't waited on, wait for the renderer to finish an asynchronous upload instead
+		if(!shouldWait)
+			app.video.awaitPendingFrameWrite();
+		restoreRunAheadState(runAheadStateSize);
+	}
+	auto bufferStats = app.video.image().takeFrameStats();
+	app.frameTimingStats.droppedFrames += bufferStats.dropped;
+	app.frameTimingStats.duplicatedFrames += bufferStats.duplicated;
 	auto endFrameTime = SteadyClock::now();
 	app.reportFrameWorkDuration(endFrameTime - frameParams.time);
 	app.record(FrameTimingStatEvent::endOfFrame, endFrameTime);
+	if(app.showFrameTimingStats)
+		threadUsageStats.update(app, endFrameTime);
 	viewCtrl.emuView.setFrameTimingStats({.stats{app.frameTimingStats}, .lastFrameTime{frameParams.lastTime},
-		.inputRate{sys.frameRate()}, .outputRate{frameRateConfig.rate}});
+		.inputRate{sys.frameRate()}, .outputRate{frameRateConfig.rate},
+		.audioLatency{app.audio ? app.audio.latency() : FloatSeconds{}}, .audioRateCorrection{app.audio.rateCorrection()},
+		.videoCopiedBytes{app.video.lastFrameCopiedBytes()}, .threadUsage{threadUsageStats.summary()}});
 	return true;
 }
 
+void EmuSystemTask::updateRunAheadState()
+{
+	if(!app.runAheadFrames || !app.system().hasContent())
+	{
+		runAheadState = {};
+		app.frameTimingStats.runAheadTime = {};
+		return;
+	}
+	// allocated up front so saving & restoring each frame doesn't allocate
+	auto stateSize = app.system().stateSize();
+	if(runAheadState.size() != stateSize)
+	{
+		log.info("allocating {} byte run-ahead state", stateSize);
+		runAheadState.resetForOverwrite(stateSize);
+	}
+}
+
+size_t EmuSystemTask::runFramesAhead(EmuVideo &video)
+{
+	// snapshot the real state then emulate ahead without audio, presenting the last frame
+	// so the effect of new input appears runAheadFrames sooner
+	auto &sys = app.system();
+	auto startTime = SteadyClock::now();
+	size_t stateSize{};
+	try
+	{
+		stateSize = sys.writeState(runAheadState, {.uncompressed = true});
+	}
+	catch(std::exception &err)
+	{
+		disableRunAhead(err.what());
+		video.startUnchangedFrame({this});
+		return 0;
+	}
+	if(app.runAheadFrames > 1)
+		sys.runFrames({this}, nullptr, nullptr, app.runAheadFrames - 1);
+	sys.runFrames({this}, &video, nullptr, 1);
+	app.frameTimingStats.runAheadTime = SteadyClock::now() - startTime;
+	return stateSize;
+}
+
+void EmuSystemTask::restoreRunAheadState(size_t size)
+{
+	auto startTime = SteadyClock::now();
+	try
+	{
+		app.system().readState(app, {runAheadState.data(), size});
+	}
+	catch(std::exception &err)
+	{
+		disableRunAhead(err.what());
+		return;
+	}
+	app.frameTimingStats.runAheadTime += SteadyClock::now() - startTime;
+}
+
+void EmuSystemTask::disableRunAhead(std::string_view error)
+{
+	log.error("disabling run-ahead:{}", error);
+	runAheadState = {};
+	app.frameTimingStats.runAheadTime = {};
+	app.runOnMainThread([&app = app, msg = std::format("Run-ahead disabled:\n{}", error)](ApplicationContext)
+	{
+		app.runAheadFrames = 0;
+		app.postErrorMessage(4, msg);
+	});
+}
+
+void EmuSystemTask::delayFrameStart(FrameParams frameParams)
+{
+	// start late enough that the frame finishes just before it's needed for the next screen refresh,
+	// so input is sampled as close as possible to presentation
+	auto &delay = app.frameTimingStats.lateStartDelay;
+	delay = {};
+	auto workEstimate = frameWorkPredictor.estimatedDuration();
+	if(!app.lateStartMarginMSecs || !workEstimate.count() || frameParams.duration.count() <= 0)
+		return;
+	auto latestStartTime = frameParams.time + frameParams.duration - workEstimate -
+		Milliseconds{app.lateStartMarginMSecs.value()};
+	auto now = SteadyClock::now();
+	if(latestStartTime <= now)
+		return;
+	std::this_thread::sleep_until(latestStartTime);
+	delay = SteadyClock::now() - now;
+}
+
 void EmuSystemTask::notifyWindowPresented()
 {
 	if(waitingForPresent_)
@@ -466,6 +594,82 @@ void EmuSystemTask::notifyWindowPresented()
 	}
 }
 
+void FrameWorkPredictor::addDuration(SteadyClockDuration duration)
+{
+	durations[nextIdx] = duration;
+	nextIdx = (nextIdx + 1) % maxDurations;
+	if(storedDurations < maxDurations)
+		storedDurations++;
+	if(storedDurations < minDurations)
+		return;
+	// use a high percentile so occasional slow frames don't miss their refresh
+	std::array<SteadyClockDuration, maxDurations> sorted;
+	auto sortedEnd = std::copy_n(durations.begin(), storedDurations, sorted.begin());
+	auto percentileIt = sorted.begin() + (storedDurations * 95) / 100;
+	std::ranges::nth_element(sorted.begin(), percentileIt, sortedEnd);
+	estimate = *percentileIt;
+}
+
+void ThreadUsageStats::update(const EmuApp& app, SteadyClockTimePoint now)
+{
+	if(!hasTime(lastUpdateTime))
+	{
+		addNewThreads(app);
+		lastUpdateTime = now;
+		return;
+	}
+	auto elapsed = now - lastUpdateTime;
+	if(elapsed < Seconds{1})
+		return;
+	lastUpdateTime = now;
+	struct RoleUsage
+	{
+		Nanoseconds cpuTime{};
+		std::optional<uint64_t> migrations;
+		int threads{};
+	};
+	std::array<RoleUsage, enumCount<ThreadRole>> roleUsage{};
+	for(auto &t : threads)
+	{
+		auto usage = t.counter.usage();
+		auto &r = roleUsage[std::to_underlying(t.role)];
+		r.cpuTime += usage.cpuTime - t.lastUsage.cpuTime;
+		if(usage.migrations)
+			r.migrations = r.migrations.value_or(0) + (*usage.migrations - t.lastUsage.migrations.value_or(0));
+		r.threads++;
+		t.lastUsage = usage;
+	}
+	auto seconds = duration_cast<FloatSeconds>(elapsed).count();
+	summary_ = "Thread CPU ms/s (migrations/s):";
+	for(auto i : iotaCount(roleUsage.size()))
+	{
+		auto &r = roleUsage[i];
+		if(!r.threads)
+			continue;
+		summary_ += std::format("\n{}: {:.1f}", enumName(ThreadRole(i)),
+			duration_cast<FloatSeconds>(r.cpuTime).count() * 1000. / seconds);
+		if(r.migrations)
+			summary_ += std::format(" ({:.0f})", *r.migrations / seconds);
+	}
+	// pick up threads that started since the last sample, like the audio callback
+	addNewThreads(app);
+}
+
+void ThreadUsageStats::addNewThreads(const EmuApp& app)
+{
+	for(auto i : iotaCount(enumCount<ThreadRole>))
+	{
+		auto role = ThreadRole(i);
+		for(auto id : app.threadIds(role))
+		{
+			if(std::ranges::any_of(threads, [&](auto &t) { return t.counter.threadId() == id; }))
+				continue;
+			auto &t = threads.emplace_back(role, ThreadUsageCounter{id});
+			t.lastUsage = t.counter.usage();
+		}
+	}
+}
+
 bool FrameRateDetector::addFrame(FrameParams params)
 {
 	if(!hasTime(params.lastTime))
@@ -70,4 +70,68 @@ void EmuTiming::reset()
 	savedAdvancedFrames = {};
 }
 
+void FrameTimingTrace::setEnabled(bool on, size_t frames)
+{
+	committedFrames.store(0, std::memory_order::relaxed);
+	current = {};
+	if(on)
+		entries.reset(frames);
+	else
+		entries = {};
+}
+
+void FrameTimingTrace::record(FrameTimingStatEvent event, SteadyClockTimePoint t)
+{
+	switch(event)
+	{
+		case FrameTimingStatEvent::startOfFrame: current.startOfFrame = t; return;
+		case FrameTimingStatEvent::startOfEmulation: current.startOfEmulation = t; return;
+		case FrameTimingStatEvent::waitForPresent: current.waitForPresent = t; return;
+		case FrameTimingStatEvent::endOfFrame: current.endOfFrame = t; return;
+	}
+	std::unreachable();
+}
+
+void FrameTimingTrace::commitFrame(size_t audioFramesWritten)
+{
+	current.audioFramesWritten = audioFramesWritten;
+	auto idx = committedFrames.load(std::memory_order::relaxed);
+	entries[idx % entries.size()] = current;
+	committedFrames.store(idx + 1, std::memory_order::release);
+	current = {};
+}
+
+std::string FrameTimingTrace::chromeTraceJson() const
+{
+	auto committed = committedFrames.load(std::memory_order::acquire);
+	auto frames = std::min(committed, entries.size());
+	auto firstIdx = committed - frames;
+	auto baseTime = frames ? entries[firstIdx % entries.size()].startOfFrame : SteadyClockTimePoint{};
+	auto toUs = [&](SteadyClockTimePoint t) { return duration_cast<FloatSeconds>(t - baseTime).count() * 1'000'000.; };
+	std::string json{"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"};
+	json += R"({"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"Frame"}},)" "\n";
+	json += R"({"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"Emulation"}})";
+	auto addSpan = [&](std::string_view name, int tid, SteadyClockTimePoint start, SteadyClockTimePoint end)
+	{
+		if(!hasTime(start) || !hasTime(end) || end < start)
+			return;
+		std::format_to(std::back_inserter(json), ",\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+			name, tid, toUs(start), toUs(end) - toUs(start));
+	};
+	for(auto i : iotaCount(frames))
+	{
+		const auto &e = entries[(firstIdx + i) % entries.size()];
+		addSpan("frame", 1, e.startOfFrame, e.endOfFrame);
+		addSpan("emulate", 2, e.startOfEmulation, e.waitForPresent);
+		addSpan("waitForPresent", 2, e.waitForPresent, e.endOfFrame);
+		if(hasTime(e.endOfFrame))
+		{
+			std::format_to(std::back_inserter(json), ",\n{{\"name\":\"audioBuffer\",\"ph\":\"C\",\"pid\":1,\"ts\":{:.3f},\"args\":{{\"framesWritten\":{}}}}}",
+				toUs(e.endOfFrame), e.audioFramesWritten);
+		}
+	}
+	json += "\n]}\n";
+	return json;
+}
+
 }
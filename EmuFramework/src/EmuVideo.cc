@@ -38,7 +38,9 @@ void EmuVideo::resetImage(PixelFormat newFmt)
 
 PixmapDesc EmuVideo::deleteImage()
 {
-	auto desc = vidImg.pixmapDesc();
+	if(!rTask)
+		return std::exchange(headlessImg, {}).desc();
+	auto desc = vidImg && cpuFilter ? cpuFilter.inputDesc() : vidImg.pixmapDesc();
 	vidImg = {};
 	return desc;
 }
@@ -66,15 +68,23 @@ bool EmuVideo::setFormat(PixmapDesc desc, EmuSystemTaskContext taskCtx)
 	{
 		return false; // no change to size/format
 	}
+	if(!rTask)
+	{
+		headlessImg = {desc};
+		log.info("resized headless image to:{}x{}", desc.w(), desc.h());
+		return true;
+	}
+	auto texDesc = cpuFilter ? cpuFilter.setInputFormat(desc) : desc;
 	if(!vidImg)
 	{
-		Gfx::TextureConfig conf{desc, samplerConfig()};
+		Gfx::TextureConfig conf{texDesc, samplerConfig()};
 		conf.colorSpace = colSpace;
-		vidImg = renderer().makePixmapBufferTexture(conf, bufferMode);
+		vidImg = renderer().makePixmapBufferTexture(conf, bufferMode,
+			app().tripleBufferVideo ? Gfx::TextureBufferImageMode::Triple : Gfx::TextureBufferImageMode{});
 	}
 	else
 	{
-		vidImg.setFormat(desc, colSpace, samplerConfig());
+		vidImg.setFormat(texDesc, colSpace, samplerConfig());
 	}
 	log.info("resized to:{}x{}", desc.w(), desc.h());
 	if(taskCtx)
@@ -86,6 +96,10 @@ bool EmuVideo::setFormat(PixmapDesc desc, EmuSystemTaskContext taskCtx)
 
 EmuVideoImage EmuVideo::startFrame(EmuSystemTaskContext taskCtx)
 {
+	if(!rTask)
+		return {taskCtx, *this, headlessImg.view()};
+	if(cpuFilter)
+		return {taskCtx, *this, cpuFilter.inputPixmap()};
 	auto lockedTex = vidImg.lock();
 	return {taskCtx, *this, lockedTex};
 }
@@ -122,6 +136,7 @@ void EmuVideo::startFrameWithAltFormat(EmuSystemTaskContext taskCtx, PixmapView
 		assume(img.pixmap().format() == PixelFmtRGB565);
 		assume(img.pixmap().size() == pix.size());
 		img.pixmap().writeConverted(pix);
+		copiedBytes += pix.unpaddedBytes();
 		img.endFrame();
 	}
 }
@@ -133,6 +148,7 @@ void EmuVideo::startUnchangedFrame(EmuSystemTaskContext taskCtx)
 
 void EmuVideo::postFrameFinished(EmuSystemTaskContext taskCtx)
 {
+	lastFrameCopiedBytes_ = std::exchange(copiedBytes, 0);
 	if(taskCtx)
 	{
 		taskCtx.task().sendFrameFinishedReply(*this);
@@ -145,6 +161,10 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, Gfx::LockedTextureBuffe
 	{
 		doScreenshot(taskCtx, texBuff.pixmap());
 	}
+	if(hashNextFrame) [[unlikely]]
+	{
+		doFrameHash(texBuff.pixmap());
+	}
 	vidImg.unlock(texBuff);
 	postFrameFinished(taskCtx);
 }
@@ -155,7 +175,27 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, PixmapView pix)
 	{
 		doScreenshot(taskCtx, pix);
 	}
-	vidImg.write(pix, {.async = true});
+	if(hashNextFrame) [[unlikely]]
+	{
+		doFrameHash(pix);
+	}
+	if(!rTask) // headless, frame was only needed for hashing
+	{
+		postFrameFinished(taskCtx);
+		return;
+	}
+	if(cpuFilter)
+	{
+		auto texBuff = vidImg.lock();
+		cpuFilter.run(app().threadPool(), texBuff.pixmap(), pix);
+		vidImg.unlock(texBuff);
+	}
+	else
+	{
+		vidImg.write(pix, {.async = true});
+		hasPendingFrameWrite = true;
+		copiedBytes += pix.unpaddedBytes();
+	}
 	postFrameFinished(taskCtx);
 }
 
@@ -166,6 +206,13 @@ void EmuVideo::clear()
 	vidImg.clear();
 }
 
+void EmuVideo::awaitPendingFrameWrite()
+{
+	if(!std::exchange(hasPendingFrameWrite, false) || !rTask)
+		return;
+	rTask->awaitPending();
+}
+
 void EmuVideo::takeGameScreenshot()
 {
 	screenshotNextFrame = true;
@@ -185,6 +232,21 @@ void EmuVideo::doScreenshot(EmuSystemTaskContext taskCtx, PixmapView pix)
 	}
 }
 
+void EmuVideo::doFrameHash(PixmapView pix)
+{
+	hashNextFrame = false;
+	// hash line by line to skip any pitch padding
+	auto lineBytes = pix.format().pixelBytes(pix.w());
+	auto data = reinterpret_cast<const uint8_t*>(pix.data());
+	uint64_t hash = fnv1aHash({});
+	for([[maybe_unused]] auto i : iotaCount(pix.h()))
+	{
+		hash = fnv1aHash({data, size_t(lineBytes)}, hash);
+		data += pix.pitchBytes();
+	}
+	frameHash = hash;
+}
+
 bool EmuVideo::isExternalTexture() const
 {
 	if constexpr(Config::envIsAndroid)
@@ -205,30 +267,48 @@ Gfx::Renderer &EmuVideo::renderer() const
 
 ApplicationContext EmuVideo::appContext() const
 {
-	return rTask->appContext();
+	return appCtx;
 }
 
 EmuVideoImage::EmuVideoImage(EmuSystemTaskContext taskCtx, EmuVideo &vid, Gfx::LockedTextureBuffer texBuff):
-	taskCtx{taskCtx}, emuVideo{&vid}, texBuff{texBuff} {}
+	taskCtx{taskCtx}, emuVideo{&vid}, texBuff{texBuff}, pix{texBuff.pixmap()} {}
+
+EmuVideoImage::EmuVideoImage(EmuSystemTaskContext taskCtx, EmuVideo &vid, MutablePixmapView filterInput):
+	taskCtx{taskCtx}, emuVideo{&vid}, pix{filterInput} {}
 
 MutablePixmapView EmuVideoImage::pixmap() const
 {
-	return texBuff.pixmap();
+	return pix;
 }
 
 EmuVideoImage::operator bool() const
 {
-	return (bool)texBuff;
+	return (bool)pix;
 }
 
 void EmuVideoImage::endFrame()
 {
-	assume(texBuff);
-	emuVideo->finishFrame(taskCtx, texBuff);
+	assume(pix);
+	if(texBuff)
+		emuVideo->finishFrame(taskCtx, texBuff);
+	else // CPU filter input scaled into the texture when finishing, or a headless image
+		emuVideo->finishFrame(taskCtx, PixmapView{pix});
 }
 
 WSize EmuVideo::size() const
 {
+	if(headlessImg)
+		return headlessImg.desc().size;
+	if(!vidImg)
+		return {1, 1};
+	else
+		return cpuFilter ? cpuFilter.inputDesc().size : vidImg.pixmapDesc().size;
+}
+
+WSize EmuVideo::outputSize() const
+{
+	if(headlessImg)
+		return headlessImg.desc().size;
 	if(!vidImg)
 		return {1, 1};
 	else
@@ -237,7 +317,9 @@ WSize EmuVideo::size() const
 
 bool EmuVideo::formatIsEqual(PixmapDesc desc) const
 {
-	return vidImg && desc == vidImg.pixmapDesc();
+	if(!rTask)
+		return headlessImg && desc == headlessImg.desc();
+	return vidImg && desc == (cpuFilter ? cpuFilter.inputDesc() : vidImg.pixmapDesc());
 }
 
 void EmuVideo::setTextureBufferMode(EmuSystem &sys, Gfx::TextureBufferMode mode)
@@ -273,8 +355,8 @@ bool EmuVideo::setRenderPixelFormat(EmuSystem &sys, PixelFormat fmt, Gfx::ColorS
 		}
 	}
 	assume(fmt);
-	assume(bufferMode != Gfx::TextureBufferMode::DEFAULT);
-	if(fmt == PixelFmtRGBA8888 && renderer().hasBgraFormat(bufferMode))
+	assume(!rTask || bufferMode != Gfx::TextureBufferMode::DEFAULT);
+	if(fmt == PixelFmtRGBA8888 && rTask && renderer().hasBgraFormat(bufferMode))
 		fmt = PixelFmtBGRA8888;
 	if(renderFmt == fmt)
 		return false;
@@ -289,6 +371,21 @@ bool EmuVideo::setRenderPixelFormat(EmuSystem &sys, PixelFormat fmt, Gfx::ColorS
 	return true;
 }
 
+bool EmuVideo::setCPUImageFilter(CPUImageFilterId id)
+{
+	if(cpuFilter.id() == id)
+		return false;
+	log.info("setting CPU image filter:{}", to_underlying(id));
+	auto oldPixDesc = deleteImage();
+	cpuFilter.setId(id);
+	if(oldPixDesc.w())
+	{
+		setFormat(oldPixDesc);
+	}
+	app().renderSystemFramebuffer(*this);
+	return true;
+}
+
 PixelFormat EmuVideo::renderPixelFormat() const
 {
 	assume(isValidRenderFormat(renderFmt));
@@ -231,8 +231,17 @@ void EmuVideoLayer::setEffect(EmuSystem &sys, ImageEffectId effect, PixelFormat
 	updateEffect(sys, fmt);
 }
 
+void EmuVideoLayer::setCPUFilter(EmuSystem &sys, CPUImageFilterId id, PixelFormat fmt)
+{
+	if(userCPUFilterId == id)
+		return;
+	userCPUFilterId = id;
+	updateEffect(sys, fmt);
+}
+
 void EmuVideoLayer::updateEffect(EmuSystem &sys, PixelFormat fmt)
 {
+	video.setCPUImageFilter(userCPUFilterId);
 	if(userEffectId == ImageEffectId::DIRECT)
 	{
 		userEffect = {};
@@ -243,7 +252,7 @@ void EmuVideoLayer::updateEffect(EmuSystem &sys, PixelFormat fmt)
 	}
 	else
 	{
-		userEffect = {renderer(), userEffectId, fmt, colorSpace(), samplerConfig(), video.size()};
+		userEffect = {renderer(), userEffectId, fmt, colorSpace(), samplerConfig(), video.outputSize()};
 		buildEffectChain();
 		video.setRenderPixelFormat(sys, video.renderPixelFormat(), Gfx::ColorSpace::LINEAR);
 	}
@@ -301,7 +310,7 @@ void EmuVideoLayer::updateEffectImageSize()
 	auto &r = renderer();
 	for(auto &e : effects)
 	{
-		e->setImageSize(r, video.size(), e == effects.back() ? samplerConfig() : Gfx::SamplerConfigs::noLinearNoMipClamp);
+		e->setImageSize(r, video.outputSize(), e == effects.back() ? samplerConfig() : Gfx::SamplerConfigs::noLinearNoMipClamp);
 	}
 }
 
@@ -324,7 +333,7 @@ bool EmuVideoLayer::updateConvertColorSpaceEffect()
 		&& userEffectId == ImageEffectId::DIRECT;
 	if(needsConversion && !userEffect)
 	{
-		userEffect = {renderer(), ImageEffectId::DIRECT, PixelFmtRGBA8888, Gfx::ColorSpace::SRGB, samplerConfig(), video.size()};
+		userEffect = {renderer(), ImageEffectId::DIRECT, PixelFmtRGBA8888, Gfx::ColorSpace::SRGB, samplerConfig(), video.outputSize()};
 		log.info("made sRGB conversion effect");
 		buildEffectChain();
 		return true;
@@ -417,6 +426,7 @@ bool EmuVideoLayer::readConfig(MapIO &io, unsigned key)
 		case CFGKEY_VIDEO_BRIGHTNESS: return readOptionValue(io, brightnessUnscaled);
 		case CFGKEY_GAME_IMG_FILTER: return readOptionValue(io, useLinearFilter);
 		case CFGKEY_IMAGE_EFFECT: return readOptionValue(io, userEffectId, [](auto m){return m <= lastEnum<ImageEffectId>;});
+		case CFGKEY_CPU_IMAGE_FILTER: return readOptionValue(io, userCPUFilterId, [](auto m){return m <= lastEnum<CPUImageFilterId>;});
 		case CFGKEY_OVERLAY_EFFECT: return readOptionValue(io, userOverlayEffectId, [](auto m){return m <= lastEnum<ImageOverlayId>;});
 		case CFGKEY_OVERLAY_EFFECT_LEVEL: return readOptionValue<int8_t>(io, [&](auto i){if(i >= 0 && i <= 100) setOverlayIntensity(i / 100.f); });
 	}
@@ -429,6 +439,7 @@ void EmuVideoLayer::writeConfig(FileIO &io) const
 		writeOptionValue(io, CFGKEY_VIDEO_BRIGHTNESS, brightnessUnscaled);
 	writeOptionValueIfNotDefault(io, CFGKEY_GAME_IMG_FILTER, useLinearFilter, true);
 	writeOptionValueIfNotDefault(io, CFGKEY_IMAGE_EFFECT, userEffectId, ImageEffectId{});
+	writeOptionValueIfNotDefault(io, CFGKEY_CPU_IMAGE_FILTER, userCPUFilterId, CPUImageFilterId{});
 	writeOptionValueIfNotDefault(io, CFGKEY_OVERLAY_EFFECT, userOverlayEffectId, ImageOverlayId{});
 	writeOptionValueIfNotDefault(io, CFGKEY_OVERLAY_EFFECT_LEVEL, int8_t(overlayIntensity() * 100.f), 75);
 }
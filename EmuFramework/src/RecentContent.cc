@@ -26,12 +26,12 @@ using namespace IG;
 
 constexpr SystemLogger log{"RecentContent"};
 
-void RecentContent::add(std::string_view fullPath, std::string_view name)
+void RecentContent::add(std::string_view fullPath, std::string_view name, const ArchiveEntryInfo &archiveEntry)
 {
 	if(fullPath.empty())
 		return;
 	log.info("adding {} @ {} to recent list, current size:{}", name, fullPath, recentContentList.size());
-	RecentContentInfo recent{FS::PathString{fullPath}, FS::FileString{name}};
+	RecentContentInfo recent{FS::PathString{fullPath}, FS::FileString{name}, archiveEntry};
 	eraseFirst(recentContentList, recent); // remove existing entry so it's added to the front
 	recentContentList.insert(recentContentList.begin(), recent);
 	if(recentContentList.size() > maxRecentContent)
@@ -46,7 +46,15 @@ void RecentContent::add(std::string_view fullPath, std::string_view name)
 
 void RecentContent::add(const EmuSystem &system)
 {
-	add(system.contentLocation(), system.contentDisplayName());
+	add(system.contentLocation(), system.contentDisplayName(), system.contentArchiveEntry());
+}
+
+ArchiveEntryInfo RecentContent::archiveEntry(std::string_view path) const
+{
+	auto it = std::ranges::find_if(recentContentList, [&](const auto &e) { return e.path == path; });
+	if(it == recentContentList.end())
+		return {};
+	return it->archiveEntry;
 }
 
 void RecentContent::writeConfig(FileIO& io) const
@@ -63,6 +71,15 @@ void RecentContent::writeContent(FileIO& io) const
 		writeOptionValueHeader(io, CFGKEY_RECENT_CONTENT_V2, size);
 		io.put(uint16_t(e.path.size()));
 		io.write(e.path.data(), e.path.size());
+		if(const auto &entry = e.archiveEntry)
+		{
+			writeOptionValueHeader(io, CFGKEY_RECENT_CONTENT_ARCHIVE_ENTRY, 18 + entry.name.size());
+			io.put(entry.index);
+			io.put(entry.crc32);
+			io.put(entry.size);
+			io.put(uint16_t(entry.name.size()));
+			io.write(entry.name.data(), entry.name.size());
+		}
 	}
 }
 
@@ -84,6 +101,7 @@ bool RecentContent::readContent(MapIO& io, const EmuSystem& system)
 		log.error("error reading string option");
 		return false;
 	}
+	skippedLastContent = true;
 	if(path.empty())
 		return true; // don't add empty paths
 	auto displayName = system.contentDisplayNameForPath(path);
@@ -92,10 +110,29 @@ bool RecentContent::readContent(MapIO& io, const EmuSystem& system)
 		log.info("skipping missing recent content:{}", path);
 		return true;
 	}
+	skippedLastContent = false;
 	RecentContentInfo info{path, displayName};
 	const auto &added = recentContentList.emplace_back(info);
 	log.info("added game to recent list:{}, name:{}", added.path, added.name);
 	return true;
 }
 
+bool RecentContent::readArchiveEntry(MapIO& io)
+{
+	// applies to the content entry read just before it
+	if(skippedLastContent || recentContentList.empty())
+		return true;
+	ArchiveEntryInfo entry;
+	entry.index = io.get<uint32_t>();
+	entry.crc32 = io.get<uint32_t>();
+	entry.size = io.get<uint64_t>();
+	if(readSizedData<uint16_t>(io, entry.name) == -1)
+	{
+		log.error("error reading archive entry option");
+		return false;
+	}
+	recentContentList.back().archiveEntry = entry;
+	return true;
+}
+
 }
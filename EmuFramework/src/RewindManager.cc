@@ -24,83 +24,372 @@ namespace EmuEx
 using namespace IG;
 
 constexpr SystemLogger log{"RewindMgr"};
-constexpr Seconds defaultSaveFreq{1};
 
-RewindManager::RewindManager(EmuApp &app):
-	saveTimer
+// Delta stream format: repeated [equal byte count][changed byte count][changed bytes XOR'd with the newer state],
+// counts are LEB128 varints. Short equal runs are folded into the changed bytes to keep the token overhead low
+constexpr size_t minEqualRun = 8;
+
+static size_t maxEncodedDeltaSize(size_t size) { return size + size / 2 + 32; }
+
+static uint8_t *writeVarint(uint8_t *out, size_t val)
+{
+	while(val >= 0x80)
+	{
+		*out++ = uint8_t(val) | 0x80;
+		val >>= 7;
+	}
+	*out++ = uint8_t(val);
+	return out;
+}
+
+static size_t readVarint(const uint8_t *&in)
+{
+	size_t val{};
+	for(int shift = 0;; shift += 7)
+	{
+		auto b = *in++;
+		val |= size_t(b & 0x7F) << shift;
+		if(!(b & 0x80))
+			return val;
+	}
+}
+
+static size_t skipEqualBytes(const uint8_t *a, const uint8_t *b, size_t pos, size_t end)
+{
+	for(; pos + sizeof(uint64_t) <= end; pos += sizeof(uint64_t))
+	{
+		if(std::memcmp(&a[pos], &b[pos], sizeof(uint64_t)))
+			break;
+	}
+	while(pos < end && a[pos] == b[pos])
+		pos++;
+	return pos;
+}
+
+static size_t encodeDelta(uint8_t *out, const uint8_t *newer, const uint8_t *older, size_t size)
+{
+	auto outStart = out;
+	size_t pos{};
+	while(pos < size)
+	{
+		auto equalStart = pos;
+		pos = skipEqualBytes(newer, older, pos, size);
+		auto changedStart = pos;
+		while(pos < size)
+		{
+			if(newer[pos] != older[pos])
+			{
+				pos++;
+				continue;
+			}
+			auto equalEnd = skipEqualBytes(newer, older, pos, std::min(size, pos + minEqualRun));
+			if(equalEnd - pos == minEqualRun || equalEnd == size)
+				break;
+			pos = equalEnd;
+		}
+		out = writeVarint(out, changedStart - equalStart);
+		out = writeVarint(out, pos - changedStart);
+		for(auto i : iotaCount(pos - changedStart))
+		{
+			*out++ = newer[changedStart + i] ^ older[changedStart + i];
+		}
+	}
+	return out - outStart;
+}
+
+static void applyDelta(uint8_t *state, std::span<const uint8_t> delta)
+{
+	auto in = delta.data();
+	auto inEnd = in + delta.size();
+	size_t pos{};
+	while(in < inEnd)
 	{
-		defaultSaveFreq,
-		{.debugLabel = "RewindManager::saveStateTimer"},
-		[this, &app]
+		pos += readVarint(in);
+		auto changed = readVarint(in);
+		for(auto i : iotaCount(changed))
 		{
-			//log.debug("running rewind save state timer");
-			saveState(app);
-			saveTimer.update();
-			return true;
+			state[pos + i] ^= in[i];
 		}
-	} {}
+		pos += changed;
+		in += changed;
+	}
+}
+
+RewindManager::~RewindManager()
+{
+	stopEncodeThread();
+}
 
 void RewindManager::clear()
 {
-	saveTimer.cancel();
-	stateEntries = {};
-	stateIdx = 0;
+	stopEncodeThread();
+	freeBuffers();
+	clearDeltas();
+	lastStateSize = 0;
 	stateSize = 0;
 }
 
+void RewindManager::freeBuffers()
+{
+	for(auto &slot : captureSlots)
+	{
+		slot.state = {};
+		slot.status.store(CaptureStatus::free, std::memory_order::relaxed);
+	}
+	lastState = {};
+	encodeBuff = {};
+	deltaBuff = {};
+}
+
 bool RewindManager::reset()
 {
 	if(!stateSize)
 		return true;
-	try
+	stopEncodeThread();
+	clearDeltas();
+	lastStateSize = 0;
+	captureSequence = encodedSequence = 0;
+	framesSinceCapture = 0;
 	{
-		if(maxStates)
-			log.info("allocating {} states of size:{}", maxStates, stateSize);
-		stateEntries.reset(maxStates, stateSize);
-		stateIdx = 0;
+		std::scoped_lock lock{intervalMutex};
+		captureInterval = frameInterval;
+	}
+	if(!maxMemoryMiB)
+	{
+		freeBuffers();
 		return true;
 	}
+	try
+	{
+		size_t budget = size_t(maxMemoryMiB) * 1024 * 1024;
+		auto encodeBuffSize = maxEncodedDeltaSize(stateSize);
+		auto fixedSize = stateSize * (captureSlots.size() + 1) + encodeBuffSize;
+		auto deltaBuffSize = budget > fixedSize ? budget - fixedSize : 0;
+		log.info("allocating {} byte delta buffer for states of size:{}", deltaBuffSize, stateSize);
+		for(auto &slot : captureSlots)
+		{
+			slot.state.resetForOverwrite(stateSize);
+			slot.status.store(CaptureStatus::free, std::memory_order::relaxed);
+		}
+		lastState.resetForOverwrite(stateSize);
+		encodeBuff.resetForOverwrite(encodeBuffSize);
+		deltaBuff.resetForOverwrite(deltaBuffSize);
+	}
 	catch(...)
 	{
+		freeBuffers();
 		return false;
 	}
+	startEncodeThread();
+	return true;
 }
 
-void RewindManager::saveState(EmuApp &app)
+void RewindManager::migrateMaxStates()
 {
-	assume(maxStates);
-	assume(stateIdx < maxStates);
-	//log.debug("saving rewind state index:{}", stateIdx);
-	auto &entry = stateEntries[stateIdx];
-	stateIdx = stateIdx + 1 == maxStates ? 0 : stateIdx + 1;
-	entry.size = app.writeState({entry.data, stateSize}, {.uncompressed = true});
+	if(!oldMaxStates || !stateSize)
+		return;
+	if(!maxMemoryMiB)
+	{
+		// give the delta ring at least the memory the old full state ring used
+		size_t mib = divRoundUp(size_t(oldMaxStates) * stateSize, size_t(1024 * 1024));
+		maxMemoryMiB = std::min(mib, size_t(maxRewindMemoryMiB));
+		log.info("converted {} rewind states of size:{} to {}MiB", oldMaxStates, stateSize, maxMemoryMiB);
+	}
+	oldMaxStates = 0;
 }
 
-void RewindManager::rewindState(EmuApp &app)
+void RewindManager::startEncodeThread()
 {
-	if(!maxStates)
+	encodeThread.reset([this](WorkThread::Context ctx)
+	{
+		while(true)
+		{
+			encodeSem.acquire();
+			if(ctx.stop)
+				return;
+			encodePending.store(false, std::memory_order::relaxed);
+			std::scoped_lock lock{mutex};
+			encodeCapturedStates();
+		}
+	});
+}
+
+void RewindManager::stopEncodeThread()
+{
+	if(!encodeThread.joinable())
 		return;
-	assume(stateIdx < maxStates);
-	auto prevIdx = stateIdx ? stateIdx - 1 : maxStates - 1;
-	auto &entry = stateEntries[prevIdx];
-	if(!entry.size)
+	encodeThread.requestStop(ThreadStop::QUIT);
+	encodeSem.release();
+	encodeThread.join();
+	encodePending.store(false, std::memory_order::relaxed);
+	// drain a possible extra wakeup so the next thread starts clean
+	encodeSem.try_acquire();
+}
+
+void RewindManager::clearDeltas()
+{
+	deltas.clear();
+	writeOffset = 0;
+	deltaBytes = 0;
+	deltaStateBytes = 0;
+}
+
+void RewindManager::popOldestDelta()
+{
+	auto &entry = deltas.front();
+	deltaBytes -= entry.size;
+	deltaStateBytes -= entry.stateSize;
+	deltas.pop_front();
+}
+
+void RewindManager::storeDelta(std::span<const uint8_t> delta, size_t prevStateSize)
+{
+	if(delta.size() > deltaBuff.size())
+	{
+		// history can't be kept, only the newest state remains
+		clearDeltas();
 		return;
-	log.info("rewinding to state index:{}", prevIdx);
-	app.readState({entry.data, std::exchange(entry.size, 0)});
-	stateIdx = prevIdx;
-	saveTimer.reset();
+	}
+	if(writeOffset + delta.size() > deltaBuff.size())
+	{
+		// wrap around, the oldest entries are at the end of the buffer
+		while(deltas.size() && deltas.front().offset >= writeOffset)
+			popOldestDelta();
+		writeOffset = 0;
+	}
+	auto writeEnd = writeOffset + delta.size();
+	while(deltas.size() && deltas.front().offset < writeEnd && deltas.front().offset + deltas.front().size > writeOffset)
+		popOldestDelta();
+	copy_n(delta.data(), delta.size(), &deltaBuff[writeOffset]);
+	deltas.emplace_back(writeOffset, uint32_t(delta.size()), uint32_t(prevStateSize));
+	deltaBytes += delta.size();
+	deltaStateBytes += prevStateSize;
+	writeOffset = writeEnd;
 }
 
-void RewindManager::startTimer()
+void RewindManager::captureFrames(EmuSystem &sys, int frames)
 {
-	if(!stateEntries.size())
+	if(!encodeThread.joinable())
+		return;
+	std::scoped_lock intervalLock{intervalMutex};
+	framesSinceCapture += frames;
+	if(framesSinceCapture < captureInterval)
+		return;
+	auto slotIt = std::ranges::find_if(captureSlots,
+		[](auto &slot){ return slot.status.load(std::memory_order::acquire) == CaptureStatus::free; });
+	if(slotIt == captureSlots.end())
+	{
+		// encoder is still busy with earlier states, try again next frame
 		return;
-	saveTimer.start();
+	}
+	framesSinceCapture = 0;
+	auto &slot = *slotIt;
+	auto startTime = SteadyClock::now();
+	slot.size = sys.writeState(slot.state, {.uncompressed = true});
+	auto captureTime = SteadyClock::now() - startTime;
+	// spread the capture cost so the average time added per emulated frame stays within budget
+	auto neededInterval = std::max(int(frameInterval), int(divRoundUp(captureTime.count(), Nanoseconds{captureTimeBudget}.count())));
+	if(neededInterval != captureInterval)
+	{
+		log.info("capture took {}, using frame interval:{}", duration_cast<Microseconds>(captureTime), neededInterval);
+		captureInterval = neededInterval;
+	}
+	slot.sequence = captureSequence++;
+	slot.status.store(CaptureStatus::captured, std::memory_order::release);
+	if(!encodePending.exchange(true, std::memory_order::relaxed))
+		encodeSem.release();
+}
+
+void RewindManager::encodeCapturedStates()
+{
+	while(true)
+	{
+		auto slotIt = std::ranges::find_if(captureSlots, [&](auto &slot)
+		{
+			return slot.status.load(std::memory_order::acquire) == CaptureStatus::captured && slot.sequence == encodedSequence;
+		});
+		if(slotIt == captureSlots.end())
+			return;
+		auto &slot = *slotIt;
+		encodedSequence++;
+		auto size = slot.size;
+		// keep the unused tail zeroed so states of different sizes XOR cleanly
+		std::fill(slot.state.begin() + size, slot.state.end(), 0);
+		if(lastStateSize)
+		{
+			auto encodedSize = encodeDelta(encodeBuff.data(), slot.state.data(), lastState.data(), std::max(size, lastStateSize));
+			//log.debug("saving rewind state with delta size:{} ({} bytes uncompressed)", encodedSize, lastStateSize);
+			storeDelta({encodeBuff.data(), encodedSize}, lastStateSize);
+		}
+		std::swap(lastState, slot.state);
+		lastStateSize = size;
+		slot.status.store(CaptureStatus::free, std::memory_order::release);
+	}
+}
+
+// Returns true if an older state was loaded, otherwise the current frame should be held
+// so rewinding moves back in steps of the capture interval at normal speed
+bool RewindManager::rewindFrames(EmuApp &app, int frames)
+{
+	framesSinceCapture = 0;
+	bool stepNow = rewindRequested.exchange(false, std::memory_order::relaxed);
+	framesSinceRewind += frames;
+	{
+		std::scoped_lock intervalLock{intervalMutex};
+		if(!stepNow && framesSinceRewind < captureInterval)
+			return false;
+	}
+	framesSinceRewind = 0;
+	std::scoped_lock lock{mutex};
+	encodeCapturedStates();
+	if(!lastStateSize)
+		return false;
+	//log.debug("rewinding to state, {} older states remain", deltas.size());
+	auto &sys = app.system();
+	sys.readState(app, {lastState.data(), lastStateSize});
+	sys.clearInputBuffers();
+	if(deltas.size())
+	{
+		auto entry = deltas.back();
+		deltas.pop_back();
+		deltaBytes -= entry.size;
+		deltaStateBytes -= entry.stateSize;
+		applyDelta(lastState.data(), {&deltaBuff[entry.offset], entry.size});
+		lastStateSize = entry.stateSize;
+		writeOffset = entry.offset;
+	}
+	else
+	{
+		lastStateSize = 0;
+	}
+	return true;
+}
+
+void RewindManager::pause()
+{
+	setRewinding(false);
+	std::scoped_lock lock{mutex};
+	encodeCapturedStates();
+}
+
+RewindManager::HistoryStats RewindManager::historyStats() const
+{
+	std::scoped_lock lock{mutex};
+	if(!lastStateSize)
+		return {};
+	return
+	{
+		.states = deltas.size() + 1,
+		.bytes = deltaBytes + lastStateSize,
+		.compressionRatio = deltaBytes ? double(deltaStateBytes) / deltaBytes : 1.,
+	};
 }
 
-void RewindManager::pauseTimer()
+void RewindManager::setFrameInterval(uint16_t frames)
 {
-	saveTimer.pause();
+	std::scoped_lock lock{intervalMutex};
+	frameInterval = frames;
+	captureInterval = frames;
 }
 
 bool RewindManager::readConfig(MapIO &io, unsigned key)
@@ -108,19 +397,23 @@ bool RewindManager::readConfig(MapIO &io, unsigned key)
 	switch(key)
 	{
 		default: return false;
-		case CFGKEY_REWIND_STATES: return readOptionValue<uint32_t>(io, [&](auto m){ maxStates = m; });
+		case CFGKEY_REWIND_MEMORY: return readOptionValue(io, maxMemoryMiB, [](auto m){ return m <= maxRewindMemoryMiB; });
+		case CFGKEY_REWIND_STATES: return readOptionValue(io, oldMaxStates); // converted to a memory size in migrateMaxStates()
+		case CFGKEY_REWIND_FRAME_INTERVAL: return readOptionValue<uint16_t>(io, [&](auto f){ setFrameInterval(f); },
+			[](auto f){ return f >= 1 && f <= maxRewindFrameInterval; });
 		case CFGKEY_REWIND_TIMER_SECS: return readOptionValue<int16_t>(io, [&](auto s)
 		{
+			// convert from the old timer option
 			if(s > 0)
-				saveTimer.frequency = Seconds{s};
+				setFrameInterval(std::min(s * 60, int(maxRewindFrameInterval)));
 		});
 	}
 }
 
 void RewindManager::writeConfig(FileIO &io) const
 {
-	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_STATES, uint32_t(maxStates), 0u);
-	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_TIMER_SECS, int16_t(saveTimer.frequency.count()), defaultSaveFreq.count());
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_MEMORY, maxMemoryMiB, uint16_t{});
+	writeOptionValueIfNotDefault(io, CFGKEY_REWIND_FRAME_INTERVAL, frameInterval, defaultRewindFrameInterval);
 }
 
 }
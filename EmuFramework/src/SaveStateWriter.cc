@@ -0,0 +1,144 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/SaveStateWriter.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/AppMeta.hh>
+import imagine;
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+constexpr SystemLogger log{"StateWriter"};
+
+// deflate's worst case expansion plus the gzip header & trailer
+static size_t maxCompressedSize(size_t size) { return size + (size >> 12) + (size >> 14) + (size >> 25) + 13 + 18; }
+
+SaveStateWriter::~SaveStateWriter()
+{
+	if(!writeThread.joinable())
+		return;
+	writePending.wait(true, std::memory_order::acquire);
+	writeThread.requestStop(ThreadStop::QUIT);
+	writeSem.release();
+	writeThread.join();
+}
+
+void SaveStateWriter::write(EmuSystem &sys, CStringView uri_, bool notify_)
+{
+	flush();
+	if(!writeThread.joinable())
+		startWriteThread();
+	auto size = sys.stateSize();
+	if(stateBuff.size() < size)
+		stateBuff = dynArrayForOverwrite<uint8_t>(size);
+	format = app.saveStateFormat;
+	compressionLevel = sys.stateCompressionLevel();
+	// compression is deferred to the worker for cores that normally compress inside writeState()
+	stateSize = sys.writeState(stateBuff, {.uncompressed = format != SaveStateFormat::legacy || AppMeta::compressesSaveStates});
+	uri = uri_;
+	notify = notify_;
+	error.clear();
+	resultPending = true;
+	writePending.store(true, std::memory_order::release);
+	writeSem.release();
+}
+
+bool SaveStateWriter::flush()
+{
+	if(isWriting())
+	{
+		log.info("waiting for pending state write");
+		writePending.wait(true, std::memory_order::acquire);
+	}
+	reportResult();
+	return error.empty();
+}
+
+void SaveStateWriter::startWriteThread()
+{
+	writeThread.reset([this](WorkThread::Context ctx)
+	{
+		while(true)
+		{
+			writeSem.acquire();
+			if(ctx.stop)
+				return;
+			writeFile();
+			writePending.store(false, std::memory_order::release);
+			writePending.notify_all();
+			app.appContext().runOnMainThread([this](ApplicationContext) { reportResult(); });
+		}
+	});
+}
+
+void SaveStateWriter::writeFile()
+{
+	auto ctx = app.appContext();
+	std::span<const uint8_t> data{stateBuff.data(), stateSize};
+	if(format == SaveStateFormat::lz4)
+	{
+		auto containerSize = maxStateContainerSize(data.size());
+		if(compressBuff.size() < containerSize)
+			compressBuff = dynArrayForOverwrite<uint8_t>(containerSize);
+		data = {compressBuff.data(), writeStateContainer(compressBuff, data, StateCodec::lz4)};
+	}
+	else if(AppMeta::compressesSaveStates)
+	{
+		auto compressedSize = maxCompressedSize(data.size());
+		if(compressBuff.size() < compressedSize)
+			compressBuff = dynArrayForOverwrite<uint8_t>(compressedSize);
+		data = {compressBuff.data(), compressGzip(compressBuff, data, compressionLevel)};
+	}
+	FS::PathString tempUri{uri};
+	tempUri += ".tmp";
+	try
+	{
+		{
+			auto file = ctx.openFileUri(tempUri, OpenFlags::newFile());
+			if(file.write(data).bytes != ssize_t(data.size()))
+				throw std::runtime_error("Error writing file");
+		}
+		if(!ctx.renameFileUri(tempUri, uri))
+		{
+			// some document providers won't rename over an existing file
+			ctx.removeFileUri(uri);
+			if(!ctx.renameFileUri(tempUri, uri))
+				throw std::runtime_error("Error renaming temporary file");
+		}
+		log.info("wrote {} bytes to {}", data.size(), uri);
+	}
+	catch(std::exception &err)
+	{
+		ctx.removeFileUri(tempUri);
+		error = err.what();
+	}
+}
+
+void SaveStateWriter::reportResult()
+{
+	if(!resultPending || isWriting())
+		return;
+	resultPending = false;
+	if(error.size())
+		app.postErrorMessage(4, std::format("Can't save state:\n{}", error));
+	else if(notify)
+		app.postMessage("State Saved");
+}
+
+}
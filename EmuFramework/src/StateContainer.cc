@@ -0,0 +1,185 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/StateContainer.hh>
+#include <emuframework/EmuSystem.hh>
+#include <emuframework/AppMeta.hh>
+import imagine;
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// blocks stored without compression have this bit set in their size prefix
+constexpr uint32_t storedBlockFlag = 0x80000000;
+constexpr uint32_t maxBlockSize = 16 * 1024 * 1024;
+
+static uint32_t coreId()
+{
+	auto name = AppMeta::configFilename;
+	return uint32_t(fnv1aHash({reinterpret_cast<const uint8_t*>(name.data()), name.size()}));
+}
+
+template <class T>
+static T toLittleEndian(T v)
+{
+	if constexpr(std::endian::native == std::endian::big)
+		return std::byteswap(v);
+	return v;
+}
+
+static void writeU32(uint8_t *p, uint32_t v)
+{
+	v = toLittleEndian(v);
+	std::memcpy(p, &v, sizeof(v));
+}
+
+static uint64_t readU64(const uint8_t *p)
+{
+	uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return toLittleEndian(v);
+}
+
+uint64_t stateChecksum(std::span<const uint8_t> data)
+{
+	// word-at-a-time multiply/rotate hash, much faster than the byte-wise FNV-1a for multi-MiB states
+	constexpr uint64_t prime1 = 0x9E3779B185EBCA87, prime2 = 0xC2B2AE3D27D4EB4F;
+	uint64_t hash = data.size() * prime1;
+	auto p = data.data();
+	auto words = data.size() / 8;
+	for(size_t i = 0; i < words; i++, p += 8)
+		hash = std::rotl(hash ^ (readU64(p) * prime2), 31) * prime1;
+	for(auto b : std::span{p, data.data() + data.size()})
+		hash = std::rotl(hash ^ (b * prime1), 11) * prime2;
+	hash ^= hash >> 33;
+	hash *= prime2;
+	hash ^= hash >> 29;
+	return hash;
+}
+
+size_t maxStateContainerSize(size_t stateSize)
+{
+	auto blocks = divRoundUp(stateSize, stateContainerBlockSize);
+	auto blockOverhead = sizeof(uint32_t) + lz4MaxCompressedSize(stateContainerBlockSize) - stateContainerBlockSize;
+	return sizeof(StateContainerHeader) + stateSize + blocks * blockOverhead;
+}
+
+size_t writeStateContainer(std::span<uint8_t> dest, std::span<const uint8_t> state, StateCodec codec)
+{
+	assume(dest.size() >= maxStateContainerSize(state.size()));
+	StateContainerHeader header
+	{
+		.magic = stateContainerMagic,
+		.version = toLittleEndian(stateContainerVersion),
+		.codec = codec,
+		.reserved = {},
+		.coreId = toLittleEndian(coreId()),
+		.blockSize = toLittleEndian(stateContainerBlockSize),
+		.uncompressedSize = toLittleEndian(uint64_t(state.size())),
+		.checksum = toLittleEndian(stateChecksum(state)),
+	};
+	std::memcpy(dest.data(), &header, sizeof(header));
+	auto out = dest.data() + sizeof(header);
+	if(codec == StateCodec::none)
+	{
+		std::memcpy(out, state.data(), state.size());
+		return sizeof(header) + state.size();
+	}
+	for(size_t offset = 0; offset < state.size(); offset += stateContainerBlockSize)
+	{
+		auto block = state.subspan(offset, std::min(size_t(stateContainerBlockSize), state.size() - offset));
+		auto size = compressLZ4({out + sizeof(uint32_t), lz4MaxCompressedSize(block.size())}, block);
+		if(size >= block.size())
+		{
+			std::memcpy(out + sizeof(uint32_t), block.data(), block.size());
+			size = block.size();
+			writeU32(out, size | storedBlockFlag);
+		}
+		else
+		{
+			writeU32(out, size);
+		}
+		out += sizeof(uint32_t) + size;
+	}
+	return out - dest.data();
+}
+
+std::span<uint8_t> readStateContainer(FileIO &io, DynArray<uint8_t> &buff, DynArray<uint8_t> &blockBuff, size_t maxSize)
+{
+	auto headerOpt = io.getExpected<StateContainerHeader>(0);
+	if(!headerOpt || headerOpt->magic != stateContainerMagic)
+		return {};
+	auto &header = *headerOpt;
+	if(toLittleEndian(header.version) > stateContainerVersion)
+		throw std::runtime_error("State was saved by a newer app version");
+	if(toLittleEndian(header.coreId) != coreId())
+		throw std::runtime_error("State was saved by a different emulator");
+	auto size = toLittleEndian(header.uncompressedSize);
+	auto blockSize = toLittleEndian(header.blockSize);
+	if(!size || !blockSize || blockSize > maxBlockSize)
+		throw std::runtime_error("Invalid state header");
+	// check the size before allocating so a damaged file can't request a huge buffer
+	if(size > maxSize || (header.codec == StateCodec::none && size > io.size() - sizeof(StateContainerHeader)))
+		throw std::runtime_error("Invalid state size");
+	if(buff.size() < size)
+		buff = dynArrayForOverwrite<uint8_t>(size);
+	std::span<uint8_t> state{buff.data(), size_t(size)};
+	off_t pos = sizeof(StateContainerHeader);
+	if(header.codec == StateCodec::none)
+	{
+		if(io.read(state.data(), state.size(), pos) != ssize_t(state.size()))
+			throw std::runtime_error("State data is truncated");
+	}
+	else if(header.codec == StateCodec::lz4)
+	{
+		if(blockBuff.size() < lz4MaxCompressedSize(blockSize))
+			blockBuff = dynArrayForOverwrite<uint8_t>(lz4MaxCompressedSize(blockSize));
+		for(size_t offset = 0; offset < state.size(); offset += blockSize)
+		{
+			auto block = state.subspan(offset, std::min(size_t(blockSize), state.size() - offset));
+			auto sizeOpt = io.getExpected<uint32_t>(pos);
+			if(!sizeOpt)
+				throw std::runtime_error("State data is truncated");
+			pos += sizeof(uint32_t);
+			auto compressedSize = toLittleEndian(*sizeOpt);
+			bool isStored = compressedSize & storedBlockFlag;
+			compressedSize &= ~storedBlockFlag;
+			if(compressedSize > blockBuff.size())
+				throw std::runtime_error("Invalid state block size");
+			// stored blocks are read straight into the state
+			auto readDest = isStored ? block.data() : blockBuff.data();
+			if((isStored && compressedSize != block.size()) ||
+				io.read(readDest, compressedSize, pos) != ssize_t(compressedSize))
+			{
+				throw std::runtime_error("State data is truncated");
+			}
+			pos += compressedSize;
+			if(!isStored && uncompressLZ4(block, {blockBuff.data(), compressedSize}) != block.size())
+				throw std::runtime_error("Error uncompressing state");
+		}
+	}
+	else
+	{
+		throw std::runtime_error("Unsupported state compression");
+	}
+	if(stateChecksum(state) != toLittleEndian(header.checksum))
+		throw std::runtime_error("State checksum mismatch");
+	return state;
+}
+
+}
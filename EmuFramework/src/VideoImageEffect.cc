@@ -72,7 +72,7 @@ static Gfx::Shader makeEffectVertexShader(Gfx::Renderer &r, std::string_view src
 		posDefs,
 		src
 	};
-	return r.makeCompatShader(shaderSrc, Gfx::ShaderType::VERTEX);
+	return r.makeCompatShader(shaderSrc, Gfx::ShaderType::VERTEX, true);
 }
 
 static Gfx::Shader makeEffectFragmentShader(Gfx::Renderer &r, std::string_view src)
@@ -83,7 +83,72 @@ static Gfx::Shader makeEffectFragmentShader(Gfx::Renderer &r, std::string_view s
 		"uniform sampler2D TEX;\n",
 		src
 	};
-	return r.makeCompatShader(shaderSrc, Gfx::ShaderType::FRAGMENT);
+	return r.makeCompatShader(shaderSrc, Gfx::ShaderType::FRAGMENT, true);
+}
+
+static std::span<const uint8_t> asBytes(std::string_view str)
+{
+	return {reinterpret_cast<const uint8_t*>(str.data()), str.size()};
+}
+
+// Linked effect programs are cached by a hash of their sources and the driver, so the
+// GLSL compiler only runs the first time an effect is used or after a driver update
+
+struct ProgramCacheHeader
+{
+	static constexpr uint32_t magicValue = 0x42505845; // "EXPB"
+
+	uint32_t magic{};
+	uint32_t format{};
+};
+
+static FS::PathString programCachePath(Gfx::Renderer &r, std::string_view vShaderSrc, std::string_view fShaderSrc)
+{
+	if(!r.supportsProgramBinaries())
+		return {};
+	auto key = fnv1aHash(asBytes(r.driverName()));
+	key = fnv1aHash(asBytes(vShaderSrc), key);
+	key = fnv1aHash(asBytes(fShaderSrc), key);
+	auto dir = FS::createDirectorySegments(r.appContext().cachePath(), "shaders");
+	return FS::pathString(dir, std::format("{:016x}.bin", key));
+}
+
+static Gfx::Program loadCachedProgram(Gfx::Renderer &r, CStringView path, std::span<Gfx::UniformLocationDesc> uniformDescs)
+{
+	auto buff = FileUtils::bufferFromPath(path, {.test = true});
+	if(buff.size() <= sizeof(ProgramCacheHeader))
+		return {};
+	ProgramCacheHeader header;
+	std::memcpy(&header, buff.data(), sizeof(header));
+	if(header.magic != ProgramCacheHeader::magicValue)
+		return {};
+	auto binData = buff.span().subspan(sizeof(header));
+	Gfx::ProgramBinary bin{{binData.begin(), binData.end()}, header.format};
+	Gfx::Program prog{r.task(), bin, {.backgroundCompile = true}, uniformDescs};
+	if(!prog)
+	{
+		log.info("removing stale program cache:{}", path);
+		FS::remove(path);
+	}
+	return prog;
+}
+
+static void saveCachedProgram(Gfx::Program &prog, CStringView path)
+{
+	auto bin = prog.binary();
+	if(!bin)
+		return;
+	try
+	{
+		FileIO file{path, OpenFlags::newFile()};
+		file.write(ProgramCacheHeader{ProgramCacheHeader::magicValue, bin.format});
+		file.write(bin.data.data(), bin.data.size());
+		log.info("cached {} byte program binary to:{}", bin.data.size(), path);
+	}
+	catch(std::exception &err)
+	{
+		log.error("error writing program cache:{}", err.what());
+	}
 }
 
 static PixelFormat effectFormat(PixelFormat format, Gfx::ColorSpace colSpace)
@@ -158,34 +223,47 @@ void VideoImageEffect::compileEffect(Gfx::Renderer &r, EffectDesc desc, bool use
 {
 	auto ctx = r.appContext();
 	const char *fallbackStr = useFallback ? "fallback-" : "";
-	auto releaseShaderCompiler = scopeGuard([&](){ r.autoReleaseShaderCompiler(); });
+	auto vShaderSrc = ctx.openAsset(IG::format<FS::PathString>("shaders/{}{}", fallbackStr, desc.vShaderFilename),
+		{.accessHint = IOAccessHint::All}).buffer();
+	auto fShaderSrc = ctx.openAsset(IG::format<FS::PathString>("shaders/{}{}", fallbackStr, desc.fShaderFilename),
+		{.accessHint = IOAccessHint::All}).buffer();
+	Gfx::UniformLocationDesc uniformDescs[]
+	{
+		{"srcTexelDelta", &srcTexelDeltaU},
+		{"srcTexelHalfDelta", &srcTexelHalfDeltaU},
+		{"srcPixels", &srcPixelsU},
+	};
+	auto cachePath = programCachePath(r, vShaderSrc.stringView(), fShaderSrc.stringView());
+	if(cachePath.size())
+	{
+		prog = loadCachedProgram(r, cachePath, uniformDescs);
+		if(prog)
+		{
+			updateProgramUniforms(r);
+			return;
+		}
+	}
 
-	auto vShader = makeEffectVertexShader(r,
-		ctx.openAsset(IG::format<FS::PathString>("shaders/{}{}", fallbackStr, desc.vShaderFilename),
-		{.accessHint = IOAccessHint::All}).buffer().stringView());
+	auto releaseShaderCompiler = scopeGuard([&](){ r.autoReleaseShaderCompiler(); });
+	auto vShader = makeEffectVertexShader(r, vShaderSrc.stringView());
 	if(!vShader)
 	{
 		throw std::runtime_error{"GPU rejected shader (vertex compile error)"};
 	}
 
-	auto fShader = makeEffectFragmentShader(r,
-		ctx.openAsset(IG::format<FS::PathString>("shaders/{}{}", fallbackStr, desc.fShaderFilename),
-		{.accessHint = IOAccessHint::All}).buffer().stringView());
+	auto fShader = makeEffectFragmentShader(r, fShaderSrc.stringView());
 	if(!fShader)
 	{
 		throw std::runtime_error{"GPU rejected shader (fragment compile error)"};
 	}
-	Gfx::UniformLocationDesc uniformDescs[]
-	{
-		{"srcTexelDelta", &srcTexelDeltaU},
-		{"srcTexelHalfDelta", &srcTexelHalfDeltaU},
-		{"srcPixels", &srcPixelsU},
-	};
-	prog = {r.task(), vShader, fShader, {.hasTexture = true}, uniformDescs};
+	prog = {r.task(), vShader, fShader,
+		{.hasTexture = true, .retrievableBinary = bool(cachePath.size()), .backgroundCompile = true}, uniformDescs};
 	if(!prog)
 	{
 		throw std::runtime_error{"GPU rejected shader (link error)"};
 	}
+	if(cachePath.size())
+		saveCachedProgram(prog, cachePath);
 	updateProgramUniforms(r);
 }
 
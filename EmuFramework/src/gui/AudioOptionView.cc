@@ -104,6 +104,20 @@ AudioOptionView::AudioOptionView(ViewAttachParams attach, EmuAudio& audio_, bool
 			audio.addSoundBuffersOnUnderrunSetting = item.flipBoolValue(*this);
 		}
 	},
+	resamplerItem
+	{
+		{"Nearest (Fastest)",           attach, {.id = AudioResamplerType::nearest}},
+		{"Windowed Sinc (High Quality)", attach, {.id = AudioResamplerType::sinc}},
+	},
+	resampler
+	{
+		"Resampler", attach,
+		MenuId{AudioResamplerType(audio_.resamplerType)},
+		resamplerItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { audio.resamplerType = AudioResamplerType(item.id.val); }
+		},
+	},
 	audioRateItem
 	{
 		[&]
@@ -186,6 +200,7 @@ void AudioOptionView::loadStockItems()
 	}
 	item.emplace_back(&soundBuffers);
 	item.emplace_back(&addSoundBuffersOnUnderrun);
+	item.emplace_back(&resampler);
 	if constexpr(Audio::Manager::HAS_SOLO_MIX)
 	{
 		item.emplace_back(&audioSoloMix);
@@ -42,9 +42,60 @@ CPUAffinityView::CPUAffinityView(ViewAttachParams attach, int cpuCount):
 			.defaultItemOnSelect = [this](TextMenuItem &item) { app().cpuAffinityMode = CPUAffinityMode(item.id.val); }
 		},
 	},
+	threadPriorityItems
+	{
+		{"Normal",                                     attach, {.id = ThreadPriority::Normal}},
+		{"High (Raise priority of frame threads)",     attach, {.id = ThreadPriority::High}},
+		{"Real-time (Use FIFO scheduling if allowed)", attach, {.id = ThreadPriority::Realtime}},
+	},
+	threadPriority
+	{
+		"Thread Priority", attach,
+		MenuId{app().threadPriority.value()},
+		std::span{threadPriorityItems, Config::envIsLinux ? 3uz : 2uz},
+		{
+			.onSetDisplayString = [this](auto idx, Gfx::Text &t)
+			{
+				t.resetString(enumName(ThreadPriority(threadPriorityItems[idx].id.val)));
+				return true;
+			},
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().threadPriority = ThreadPriority(item.id.val); }
+		},
+	},
+	placementHeading{"Thread Placement", attach},
+	placementItems
+	{
+		{"Default (Follow CPU affinity mode)", attach, {.id = ThreadPlacement::Default}},
+		{"Any Core",                           attach, {.id = ThreadPlacement::Any}},
+		{"Performance Cores",                  attach, {.id = ThreadPlacement::Performance}},
+		{"Efficiency Cores",                   attach, {.id = ThreadPlacement::Efficiency}},
+	},
+	placement
+	{
+		makePlacementItem("Emulation", ThreadRole::Emulation),
+		makePlacementItem("Renderer", ThreadRole::Renderer),
+		makePlacementItem("Core Helpers", ThreadRole::CoreHelper),
+		makePlacementItem("Audio Output", ThreadRole::Audio),
+		makePlacementItem("Media Reading", ThreadRole::IO),
+	},
 	cpusHeading{"Manual CPU Affinity", attach}
 {
+	for(auto &item : placementItems)
+	{
+		item.onSelect = [this](TextMenuItem &selectedItem)
+		{
+			auto placements = app().threadPlacement.value();
+			placements[activeRole] = ThreadPlacement(selectedItem.id.val);
+			app().threadPlacement = placements;
+		};
+	}
 	menuItems.emplace_back(&affinityMode);
+	menuItems.emplace_back(&threadPriority);
+	menuItems.emplace_back(&placementHeading);
+	for(auto &item : placement)
+	{
+		menuItems.emplace_back(&item);
+	}
 	menuItems.emplace_back(&cpusHeading);
 	cpuAffinityItems.reserve(cpuCount);
 	for(int i: iotaCount(cpuCount))
@@ -62,6 +113,28 @@ CPUAffinityView::CPUAffinityView(ViewAttachParams attach, int cpuCount):
 	}
 }
 
+MultiChoiceMenuItem CPUAffinityView::makePlacementItem(const char *name, ThreadRole role)
+{
+	return
+	{
+		name, attachParams(),
+		MenuId{app().threadPlacement.value()[role]},
+		placementItems,
+		{
+			.onSetDisplayString = [this](auto idx, Gfx::Text &t)
+			{
+				t.resetString(enumName(ThreadPlacement(placementItems[idx].id.val)));
+				return true;
+			},
+			.onSelect = [this, role](MultiChoiceMenuItem &item, View &view, const Input::Event &e)
+			{
+				activeRole = role;
+				item.defaultOnSelect(view, e);
+			},
+		},
+	};
+}
+
 void CPUAffinityView::onShow()
 {
 	bool isInManualMode = app().cpuAffinityMode == CPUAffinityMode::Manual;
@@ -35,9 +35,17 @@ public:
 protected:
 	TextMenuItem affinityModeItems[3];
 	MultiChoiceMenuItem affinityMode;
+	TextMenuItem threadPriorityItems[3];
+	MultiChoiceMenuItem threadPriority;
+	TextHeadingMenuItem placementHeading;
+	TextMenuItem placementItems[4];
+	ThreadRole activeRole{};
+	std::array<MultiChoiceMenuItem, enumCount<ThreadRole>> placement;
 	TextHeadingMenuItem cpusHeading;
 	std::vector<BoolMenuItem> cpuAffinityItems;
 	std::vector<MenuItem*> menuItems{};
+
+	MultiChoiceMenuItem makePlacementItem(const char *name, ThreadRole);
 };
 
 }
@@ -136,10 +136,35 @@ void EmuView::setFrameTimingStats(FrameTimingViewStats viewStats)
 		"Input: {:g}Hz\n"
 		"Output: {:g}Hz\n"
 		"Delta Time: {} ({:.2f}Hz)\n"
-		"Frame Time: {}",
+		"Frame Time: {}\n"
+		"Audio Latency: {:.1f}ms ({:+.2f}%)",
 		emuScreen.frameRate().hz(), clockHz,
 		viewStats.inputRate.hz(), viewStats.outputRate.hz(),
-		deltaDurationMS, toHz(deltaDuration), frameDuration);
+		deltaDurationMS, toHz(deltaDuration), frameDuration,
+		viewStats.audioLatency.count() * 1000., (viewStats.audioRateCorrection - 1.) * 100.);
+	if(stats.runAheadTime.count())
+	{
+		frameTimingStatsStr += std::format("\nRun-ahead Time: {:.2f}ms",
+			duration_cast<FloatSeconds>(stats.runAheadTime).count() * 1000.);
+	}
+	if(stats.lateStartDelay.count())
+	{
+		frameTimingStatsStr += std::format("\nLate Start Delay: {:.2f}ms",
+			duration_cast<FloatSeconds>(stats.lateStartDelay).count() * 1000.);
+	}
+	if(stats.droppedFrames || stats.duplicatedFrames)
+	{
+		frameTimingStatsStr += std::format("\nDropped/Duplicated Frames: {} {}", stats.droppedFrames, stats.duplicatedFrames);
+	}
+	if(viewStats.videoCopiedBytes)
+	{
+		frameTimingStatsStr += std::format("\nVideo Copy: {:.1f}KiB", viewStats.videoCopiedBytes / 1024.);
+	}
+	if(viewStats.threadUsage.size())
+	{
+		frameTimingStatsStr += "\n\n";
+		frameTimingStatsStr += viewStats.threadUsage;
+	}
 	if(enableFullFrameTimingStats)
 	{
 		auto callbackOverhead = duration_cast<Milliseconds>(stats.startOfEmulation - stats.startOfFrame);
@@ -342,10 +342,14 @@ static Gfx::DrawAsyncMode drawAsyncMode(bool showingEmulation)
 bool EmuViewController::drawMainWindow(Window &win, WindowDrawParams params, Gfx::RendererTask &task)
 {
 	return task.draw(win, params, {.asyncMode = drawAsyncMode(app().systemTask.waitingForPresent())},
-		[this, isBlankFrame = std::exchange(drawBlankFrame, {})](Window &win, Gfx::RendererCommands &cmds)
+		[this, isBlankFrame = std::exchange(drawBlankFrame, {}), isRunning = app().system().isActive()]
+		(Window &win, Gfx::RendererCommands &cmds)
 	{
 		auto &winData = windowData(win);
 		cmds.basicEffect().setModelViewProjection(cmds, Gfx::Mat4::ident(), winData.projM);
+		// no new frame is only a duplicate while emulation is running
+		if(winData.hasEmuView)
+			app().video.image().updateFromNewestBuffer(isRunning);
 		if(showingEmulation)
 		{
 			if(winData.hasEmuView && !isBlankFrame)
@@ -376,10 +380,11 @@ bool EmuViewController::drawMainWindow(Window &win, WindowDrawParams params, Gfx
 bool EmuViewController::drawExtraWindow(Window &win, WindowDrawParams params, Gfx::RendererTask &task)
 {
 	return task.draw(win, params, {.asyncMode = drawAsyncMode(showingEmulation)},
-		[this](Window &win, Gfx::RendererCommands &cmds)
+		[this, isRunning = app().system().isActive()](Window &win, Gfx::RendererCommands &cmds)
 	{
 		auto &winData = windowData(win);
 		cmds.basicEffect().setModelViewProjection(cmds, Gfx::Mat4::ident(), winData.projM);
+		app().video.image().updateFromNewestBuffer(isRunning);
 		emuView.draw(cmds);
 		if(winData.hasPopup)
 		{
@@ -136,6 +136,46 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 		app().lowLatencyVideo,
 		[this](BoolMenuItem& item) { app().setLowLatencyVideo(item.flipBoolValue(*this)); }
 	},
+	tripleBufferVideo
+	{
+		"Triple Buffer Video", attach,
+		app().tripleBufferVideo,
+		[this](BoolMenuItem& item) { app().setTripleBufferVideo(item.flipBoolValue(*this)); }
+	},
+	runAheadItems
+	{
+		{"Off", attach, {.id = 0}},
+		{"1",   attach, {.id = 1}},
+		{"2",   attach, {.id = 2}},
+		{"3",   attach, {.id = 3}},
+		{"4",   attach, {.id = 4}},
+	},
+	runAhead
+	{
+		"Run-ahead Frames", attach,
+		MenuId{app().runAheadFrames},
+		runAheadItems,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().runAheadFrames = item.id; }
+		},
+	},
+	lateStartItems
+	{
+		{"Off", attach, {.id = 0}},
+		{"1ms", attach, {.id = 1}},
+		{"2ms", attach, {.id = 2}},
+		{"4ms", attach, {.id = 4}},
+		{"8ms", attach, {.id = 8}},
+	},
+	lateStart
+	{
+		"Late Start Margin", attach,
+		MenuId{app().lateStartMarginMSecs},
+		lateStartItems,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().lateStartMarginMSecs = item.id; }
+		},
+	},
 	frameClockItems
 	{
 		[&]()
@@ -250,6 +290,17 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 		app().allowBlankFrameInsertion,
 		[this](BoolMenuItem &item) { app().allowBlankFrameInsertion = item.flipBoolValue(*this); }
 	},
+	recordTrace
+	{
+		"Record Frame Timing Trace", attach,
+		app().frameTimingTrace.isEnabled(),
+		[this](BoolMenuItem &item) { app().frameTimingTrace.setEnabled(item.flipBoolValue(*this)); }
+	},
+	exportTrace
+	{
+		"Export Frame Timing Trace", attach,
+		[this] { app().exportFrameTimingTrace(); }
+	},
 	advancedHeading{"Advanced", attach}
 {
 	loadStockItems();
@@ -274,6 +325,11 @@ void FrameTimingView::loadStockItems()
 	if(used(screenFrameRate) && app().emuScreen().supportedFrameRates().size() > 1)
 		item.emplace_back(&screenFrameRate);
 	item.emplace_back(&lowLatencyVideo);
+	item.emplace_back(&tripleBufferVideo);
+	item.emplace_back(&runAhead);
+	item.emplace_back(&lateStart);
+	item.emplace_back(&recordTrace);
+	item.emplace_back(&exportTrace);
 }
 
 bool FrameTimingView::onFrameRateChange(VideoSystem vidSys, SteadyClockDuration d)
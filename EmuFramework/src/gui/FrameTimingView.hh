@@ -43,6 +43,11 @@ protected:
 	MultiChoiceMenuItem frameRatePAL;
 	BoolMenuItem frameTimingStats;
 	BoolMenuItem lowLatencyVideo;
+	BoolMenuItem tripleBufferVideo;
+	TextMenuItem runAheadItems[maxRunAheadFrames + 1];
+	MultiChoiceMenuItem runAhead;
+	TextMenuItem lateStartItems[5];
+	MultiChoiceMenuItem lateStart;
 	StaticArrayList<TextMenuItem, maxFrameClockItems> frameClockItems;
 	MultiChoiceMenuItem frameClock;
 	TextMenuItem outputRateModeItems[3];
@@ -52,8 +57,10 @@ protected:
 	ConditionalMember<Config::multipleScreenFrameRates, std::vector<TextMenuItem>> screenFrameRateItems;
 	ConditionalMember<Config::multipleScreenFrameRates, MultiChoiceMenuItem> screenFrameRate;
 	BoolMenuItem blankFrameInsertion;
+	BoolMenuItem recordTrace;
+	TextMenuItem exportTrace;
 	TextHeadingMenuItem advancedHeading;
-	StaticArrayList<MenuItem*, 11> item;
+	StaticArrayList<MenuItem*, 16> item;
 
 	bool onFrameRateChange(VideoSystem, SteadyClockDuration);
 };
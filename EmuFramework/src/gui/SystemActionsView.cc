@@ -81,7 +81,7 @@ SystemActionsView::SystemActionsView(ViewAttachParams attach, bool customMenu):
 				{
 					.onYes = [this]
 					{
-						if(app().autosaveManager.save(AutosaveActionSource::Manual))
+						if(app().autosaveManager.save(AutosaveActionSource::Manual, SaveAutosaveMode::WaitForWrite))
 							app().showEmulation();
 					}
 				}), e);
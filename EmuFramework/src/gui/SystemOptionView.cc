@@ -22,6 +22,15 @@ import imagine;
 namespace EmuEx
 {
 
+static std::string rewindHistoryStr(const RewindManager &rewindManager)
+{
+	auto stats = rewindManager.historyStats();
+	if(!stats.states)
+		return "None";
+	return std::format("{} ({:.1f}MiB, {:.1f}:1)", stats.states,
+		stats.bytes / (1024. * 1024.), stats.compressionRatio);
+}
+
 SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 	TableView{"System Options", attach, item},
 	autosaveTimerItem
@@ -95,6 +104,20 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			app().confirmOverwriteState = item.flipBoolValue(*this);
 		}
 	},
+	stateFormatItem
+	{
+		{"Compact (LZ4)", attach, {.id = SaveStateFormat::lz4}},
+		{"Legacy",        attach, {.id = SaveStateFormat::legacy}},
+	},
+	stateFormat
+	{
+		"Save State Format", attach,
+		MenuId{SaveStateFormat(app().saveStateFormat)},
+		stateFormatItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { app().saveStateFormat = SaveStateFormat(item.id.val); }
+		},
+	},
 	fastModeSpeedItem
 	{
 		{"1.5x",  attach, {.id = 150}},
@@ -173,19 +196,21 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			.defaultItemOnSelect = [this](TextMenuItem &item) { app().setAltSpeed(AltSpeedMode::slow, item.id); }
 		},
 	},
-	rewindStatesItem
+	rewindMemoryItem
 	{
-		{"0",  attach, {.id = 0}},
-		{"30", attach, {.id = 30}},
-		{"60", attach, {.id = 60}},
+		{"Off",    attach, {.id = 0}},
+		{"16MiB",  attach, {.id = 16}},
+		{"64MiB",  attach, {.id = 64}},
+		{"128MiB", attach, {.id = 128}},
 		{"Custom Value", attach, [this](const Input::Event &e)
 			{
-				pushAndShowNewCollectValueRangeInputView<int, 0, 50000>(attachParams(), e,
-					"Input 0 to 50000", std::to_string(app().rewindManager.maxStates),
+				pushAndShowNewCollectValueRangeInputView<int, 0, maxRewindMemoryMiB>(attachParams(), e,
+					"Input 0 to 1024", std::to_string(app().rewindManager.maxMemoryMiB),
 					[this](CollectTextInputView &, auto val)
 					{
-						app().rewindManager.updateMaxStates(val);
-						rewindStates.setSelected(val, *this);
+						app().setRewindMemory(val);
+						rewindMemory.setSelected(val, *this);
+						app().defaultVController().updateEnabledUIButtons();
 						dismissPrevious();
 						return true;
 					});
@@ -193,34 +218,44 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			}, {.id = defaultMenuId}
 		},
 	},
-	rewindStates
+	rewindMemory
 	{
-		"States", attach,
-		MenuId{app().rewindManager.maxStates},
-		rewindStatesItem,
+		"Memory", attach,
+		MenuId{app().rewindManager.maxMemoryMiB},
+		rewindMemoryItem,
 		{
-			.onSetDisplayString = [this](auto, Gfx::Text& t)
+			.onSetDisplayString = [this](auto idx, Gfx::Text& t)
 			{
-				t.resetString(std::format("{}", app().rewindManager.maxStates));
+				if(!idx)
+					return false;
+				t.resetString(std::format("{}MiB", app().rewindManager.maxMemoryMiB));
 				return true;
 			},
 			.defaultItemOnSelect = [this](TextMenuItem &item)
 			{
-				app().rewindManager.updateMaxStates(item.id);
+				app().setRewindMemory(item.id);
 				app().defaultVController().updateEnabledUIButtons();
 			}
 		},
 	},
+	rewindHistory
+	{
+		"Stored States", rewindHistoryStr(app().rewindManager), attach,
+		[this]
+		{
+			rewindHistory.set2ndName(rewindHistoryStr(app().rewindManager));
+		}
+	},
 	rewindTimeInterval
 	{
-		"State Interval (Seconds)", std::to_string(app().rewindManager.saveTimer.frequency.count()), attach,
+		"State Interval (Frames)", std::to_string(app().rewindManager.frameInterval), attach,
 		[this](const Input::Event &e)
 		{
-			pushAndShowNewCollectValueRangeInputView<int, 1, 60>(attachParams(), e,
-				"Input 1 to 60", std::to_string(app().rewindManager.saveTimer.frequency.count()),
+			pushAndShowNewCollectValueRangeInputView<int, 1, maxRewindFrameInterval>(attachParams(), e,
+				"Input 1 to 600", std::to_string(app().rewindManager.frameInterval),
 				[this](CollectTextInputView &, auto val)
 				{
-					app().rewindManager.saveTimer.frequency = Seconds{val};
+					app().rewindManager.setFrameInterval(val);
 					rewindTimeInterval.set2ndName(std::to_string(val));
 					return true;
 				});
@@ -253,6 +288,28 @@ SystemOptionView::SystemOptionView(ViewAttachParams attach, bool customMenu):
 			pushAndShow(makeView<CPUAffinityView>(appContext().cpuCount()), e);
 		}
 	},
+	guestMemoryHugePages
+	{
+		"Huge Pages For Emulated Memory", attach,
+		app().guestMemoryHugePages,
+		[this](BoolMenuItem &item)
+		{
+			app().guestMemoryHugePages = item.flipBoolValue(*this);
+			if(system().hasContent())
+				app().postMessage("Change takes effect after reloading the content");
+		}
+	},
+	lockGuestMemory
+	{
+		"Lock Emulated Memory In RAM", attach,
+		app().lockGuestMemory,
+		[this](BoolMenuItem &item)
+		{
+			app().lockGuestMemory = item.flipBoolValue(*this);
+			if(system().hasContent())
+				app().postMessage("Change takes effect after reloading the content");
+		}
+	},
 	autosaveHeading{"Autosave Options", attach},
 	rewindHeading{"Rewind Options", attach},
 	otherHeading{"Other Options", attach}
@@ -270,10 +327,12 @@ void SystemOptionView::loadStockItems()
 	item.emplace_back(&autosaveTimer);
 	item.emplace_back(&autosaveContent);
 	item.emplace_back(&rewindHeading);
-	item.emplace_back(&rewindStates);
+	item.emplace_back(&rewindMemory);
 	item.emplace_back(&rewindTimeInterval);
+	item.emplace_back(&rewindHistory);
 	item.emplace_back(&otherHeading);
 	item.emplace_back(&confirmOverwriteState);
+	item.emplace_back(&stateFormat);
 	item.emplace_back(&fastModeSpeed);
 	item.emplace_back(&slowModeSpeed);
 	if(used(performanceMode) && appContext().hasSustainedPerformanceMode())
@@ -282,6 +341,9 @@ void SystemOptionView::loadStockItems()
 		item.emplace_back(&noopThread);
 	if(used(cpuAffinity) && appContext().cpuCount() > 1)
 		item.emplace_back(&cpuAffinity);
+	if(used(guestMemoryHugePages) && AppMeta::hasLargeGuestMemory)
+		item.emplace_back(&guestMemoryHugePages);
+	item.emplace_back(&lockGuestMemory);
 }
 
 }
@@ -272,6 +272,25 @@ VideoOptionView::VideoOptionView(ViewAttachParams attach, EmuVideoLayer &videoLa
 			}
 		},
 	},
+	cpuFilterItem
+	{
+		{"Off",     attach, {.id = CPUImageFilterId::NONE}},
+		{"Scale2x", attach, {.id = CPUImageFilterId::SCALE2X}},
+		{"Scale3x", attach, {.id = CPUImageFilterId::SCALE3X}},
+	},
+	cpuFilter
+	{
+		"CPU Image Effect", attach,
+		MenuId{videoLayer_.cpuFilterId()},
+		cpuFilterItem,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item)
+			{
+				videoLayer.setCPUFilter(system(), CPUImageFilterId(item.id.val), app().videoEffectPixelFormat());
+				app().viewController().postDrawToEmuWindows();
+			}
+		},
+	},
 	overlayEffectItem
 	{
 		{"Off",            attach, {.id = 0}},
@@ -547,6 +566,7 @@ void VideoOptionView::loadStockItems()
 {
 	item.emplace_back(&imgFilter);
 	item.emplace_back(&imgEffect);
+	item.emplace_back(&cpuFilter);
 	item.emplace_back(&overlayEffect);
 	item.emplace_back(&overlayEffectLevel);
 	item.emplace_back(&contentScale);
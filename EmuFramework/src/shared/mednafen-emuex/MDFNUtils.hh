@@ -133,12 +133,13 @@ inline BoolMenuItem saveFilenameTypeMenuItem(auto &view, auto &system)
 inline void loadContent(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, IO &io, size_t maxContentSize)
 {
 	using namespace Mednafen;
-	auto stream = std::make_unique<MemoryStream>(maxContentSize, true);
-	auto size = io.read(stream->map(), stream->map_size());
-	if(size <= 0)
+	// cores only read from the content stream so it can use the mapped file directly
+	auto content = sys.mapContent(io);
+	if(!content)
 		sys.throwFileReadError();
-	stream->setSize(size);
-	MDFNFILE fp(&NVFS, std::move(stream));
+	if(content.size() > maxContentSize)
+		throw std::runtime_error(std::format("Content size exceeds {}MiB", maxContentSize / (1024 * 1024)));
+	MDFNFILE fp(&NVFS, std::make_unique<FileStream>(std::move(content)));
 	GameFile gf{&NVFS, std::string{sys.contentDirectory()}, {}, fp.stream(),
 		std::string{dotExtension(sys.contentFileName())},
 		std::string{sys.contentName()}};
@@ -207,6 +208,11 @@ inline void readStateMDFN(std::span<uint8_t> buff)
 	}
 }
 
+inline int stateCompressionLevelMDFN()
+{
+	return Mednafen::MDFN_GetSettingI("filesys.state_comp_level");
+}
+
 inline size_t writeStateMDFN(std::span<uint8_t> buff, SaveStateFlags flags)
 {
 	using namespace Mednafen;
@@ -220,7 +226,7 @@ inline size_t writeStateMDFN(std::span<uint8_t> buff, SaveStateFlags flags)
 	{
 		MemoryStream s;
 		MDFNSS_SaveSM(&s);
-		return compressGzip(buff, {s.map(), size_t(s.size())}, MDFN_GetSettingI("filesys.state_comp_level"));
+		return compressGzip(buff, {s.map(), size_t(s.size())}, stateCompressionLevelMDFN());
 	}
 }
 
@@ -253,4 +259,13 @@ inline void clearCDInterfaces(std::vector<Mednafen::CDInterface *> &ifaces)
 	ifaces.clear();
 }
 
+inline void addCDReadThreadIds(const std::vector<Mednafen::CDInterface *> &ifaces, std::vector<ThreadId> &ids)
+{
+	for(auto cdIfPtr : ifaces)
+	{
+		if(auto id = cdIfPtr->ReadThreadID())
+			ids.emplace_back(ThreadId(id));
+	}
+}
+
 }
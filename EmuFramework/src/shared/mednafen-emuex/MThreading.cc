@@ -28,7 +28,7 @@ using namespace IG;
 
 struct Thread : public std::thread
 {
-	using thread::thread;
+	ThreadId id{};
 };
 struct Mutex : public std::mutex {};
 struct Cond : public std::condition_variable {};
@@ -39,7 +39,16 @@ struct Sem : public counting_semaphore<0x80000>
 
 Thread* Thread_Create(int (*fn)(void *), void *data, const char* debug_name)
 {
-	return new Thread{fn, data};
+	auto thread = new Thread;
+	// wait for the thread to report its ID so its affinity can be set right after creation
+	static_cast<std::thread&>(*thread) = makeThreadSync([=](auto &sem)
+	{
+		thread->id = thisThreadId();
+		sem.release();
+		fn(data);
+	});
+	log.info("created thread:{} ({})", thread->id, debug_name ? debug_name : "");
+	return thread;
 }
 
 void Thread_Wait(Thread* thread, int* status)
@@ -50,7 +59,14 @@ void Thread_Wait(Thread* thread, int* status)
 
 uint64 Thread_SetAffinity(Thread* thread, const uint64 mask)
 {
-	return 0;
+	auto prevMask = threadCPUAffinityMask(thread->id);
+	setThreadCPUAffinityMask({&thread->id, 1}, CPUMask(mask));
+	return prevMask;
+}
+
+uint64 Thread_NativeID(Thread* thread)
+{
+	return thread ? thread->id : 0;
 }
 
 Mutex* Mutex_Create(void)
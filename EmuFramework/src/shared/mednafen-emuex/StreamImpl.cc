@@ -66,6 +66,10 @@ catch(std::system_error &err)
 FileStream::FileStream(std::span<uint8_t> buff):
 	io{IG::MapIO{buff}} {}
 
+FileStream::FileStream(IG::MapIO mapIO):
+	io{std::move(mapIO)},
+	attribs{ATTRIBUTE_READABLE} {}
+
 FileStream::~FileStream() {}
 
 uint64 FileStream::attributes(void)
@@ -53,6 +53,7 @@ Thread* Thread_Create(int (*fn)(void *), void *data, const char* debug_name = nu
 void Thread_Wait(Thread *thread, int *status);
 uintptr_t Thread_ID(void);
 uint64 Thread_SetAffinity(Thread* thread, uint64 mask) MDFN_COLD;
+uint64 Thread_NativeID(Thread* thread); // EmuEx: OS thread ID for placing the thread by role
 
 //
 // Mutexes
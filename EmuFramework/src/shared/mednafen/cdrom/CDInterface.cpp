@@ -47,6 +47,11 @@ bool CDInterface::NonDeterministic_CheckSectorReady(int32 lba)
  return true;
 }
 
+uint64 CDInterface::ReadThreadID(void) const
+{
+ return 0;
+}
+
 uint8 CDInterface::ReadSectors(uint8* buf, int32 lba, uint32 sector_count)
 {
  uint8 ret = 0;
@@ -81,6 +81,9 @@ class CDInterface
  // For experimental and special use cases.
  virtual bool NonDeterministic_CheckSectorReady(int32 lba);
 
+ // EmuEx: OS thread ID of the background read thread, 0 if reads happen on the calling thread
+ virtual uint64 ReadThreadID(void) const;
+
  INLINE void ReadTOC(CDUtility::TOC* read_target)
  {
   *read_target = disc_toc;
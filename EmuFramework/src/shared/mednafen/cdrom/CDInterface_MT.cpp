@@ -399,4 +399,9 @@ void CDInterface_MT::HintReadSector(int32 lba)
  ReadThreadQueue.Write(CDInterface_Message(CDInterface_MSG_READ_SECTOR, lba));
 }
 
+uint64 CDInterface_MT::ReadThreadID(void) const
+{
+ return MThreading::Thread_NativeID(CDReadThread);
+}
+
 }
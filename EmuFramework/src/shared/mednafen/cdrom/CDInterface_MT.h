@@ -41,6 +41,7 @@ class CDInterface_MT : public CDInterface
  virtual void HintReadSector(int32 lba) override;
  virtual bool ReadRawSector(uint8 *buf, int32 lba) override;
  virtual bool ReadRawSectorPWOnly(uint8* pwbuf, int32 lba, bool hint_fullread) override;
+ virtual uint64 ReadThreadID(void) const override;
 
  // FIXME: Semi-private:
  int ReadThreadStart(void);
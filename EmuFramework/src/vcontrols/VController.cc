@@ -425,7 +425,7 @@ bool VController::keyIsEnabled(KeyInfo k) const
 
 bool VController::uiKeyIsEnabled(KeyInfo k) const
 {
-	if(AppKeyCode(k.codes[0]) == AppKeyCode::rewind && !app().rewindManager.maxStates)
+	if(AppKeyCode(k.codes[0]) == AppKeyCode::rewind && !app().rewindManager.isEnabled())
 	{
 		return false;
 	}
@@ -717,6 +717,7 @@ void gfxUpdateBG3Y(GBASys& gba) {
 #define gfxUpdateBG3Y() gfxUpdateBG3Y(gba)
 
 void gfxNewFrame(GBASys& gba) {
+    gba.lineRenderer.wait();
     gfxUpdateBG2X();
     gfxUpdateBG2Y();
     gfxUpdateBG3X();
@@ -2812,8 +2813,10 @@ void CPUCompareVCOUNT(ARM7TDMI &cpu)
   }
   if (layerEnableDelay > 0) {
   	layerEnableDelay--;
-      if (layerEnableDelay == 1)
+      if (layerEnableDelay == 1) {
+      	gba.lineRenderer.wait();
       	layerEnable = coreOptions.layerSettings & DISPCNT;
+      }
   }
 
 }
@@ -3123,6 +3126,9 @@ void CPUUpdateRegister(ARM7TDMI &cpu, uint32_t address, uint16_t value)
 	auto& IE = gba.mem.ioMem.IE;
 	auto& IME = gba.mem.ioMem.IME;
 
+  if (address < GBALineRenderer::displayRegsSize) // registers read by the line renderer
+    gba.lineRenderer.wait();
+
   switch (address) {
   case IO_REG_DISPCNT: { // we need to place the following code in { } because we declare & initialize variables in a case statement
       if ((value & 7) > 5) {
@@ -4172,7 +4178,7 @@ static bool has_frames;
 void CPULoop(GBASys &gba, EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *video, EmuEx::EmuAudio *audio)
 {
 	auto cpu = gba.cpu;
-	auto restoreCpu = IG::scopeGuard([&](){ gba.cpu = cpu; });
+	auto restoreCpu = IG::scopeGuard([&](){ gba.cpu = cpu; gba.lineRenderer.wait(); });
 	auto& armIrqEnable = cpu.armIrqEnable;
 	auto& ioMem = gba.mem.ioMem;
 	auto& g_ioMem = ioMem;
@@ -4545,13 +4551,14 @@ void CPULoop(GBASys &gba, EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *
             	else
             	{
             	}*/
-              (*gba.lcd.renderLine)(gba.lcd.lineMix, gba.lcd, ioMem);
+              gba.lineRenderer.renderLine(gba.lcd, ioMem);
             }
             if (VCOUNT == 159)
             {
             	cpuBreakLoop = true;
               if (video)
               {
+            	  gba.lineRenderer.wait();
             	  systemDrawScreen(gba.lcd, taskCtx, *video);
             	  video = nullptr;
               }
@@ -26,6 +26,7 @@ extern int thumbExecute(ARM7TDMI &cpu) __attribute__((hot));
 
 extern uint32_t mastercode;
 extern void CPUSoftwareInterrupt(ARM7TDMI &cpu, int comment);
+extern void cpuIdleLoopBranch(ARM7TDMI &cpu, uint32_t branchPC) __attribute__((cold));
 
 #define busPrefetchCount cpu.busPrefetchCount
 #define busPrefetch cpu.busPrefetch
@@ -2868,6 +2868,7 @@ int armExecute(ARM7TDMI &cpu)
 {
 	int &cpuNextEvent = cpu.cpuNextEvent;
 	int &cpuTotalTicks = cpu.cpuTotalTicks;
+	cpu.idleLoop.resetLoop();
     do {
 		if (coreOptions.cheatsEnabled) {
 			cpuMasterCodeCheck();
@@ -3016,6 +3017,9 @@ int armExecute(ARM7TDMI &cpu)
             clockTicks = 1 + codeTicksAccessSeq32(oldArmNextPC);
         cpuTotalTicks += clockTicks;
 
+        if (UNLIKELY(uint32_t(oldArmNextPC - armNextPC) < cpu.idleLoop.maxBranchDistance))
+            cpuIdleLoopBranch(cpu, oldArmNextPC);
+
     } while (cpuTotalTicks < cpuNextEvent &&
     		(!CONFIG_TRIGGER_ARM_STATE_EVENT && armState) && !cpu.SWITicks);
     return 1;
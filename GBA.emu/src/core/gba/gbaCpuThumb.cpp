@@ -2114,6 +2114,7 @@ int thumbExecute(ARM7TDMI &cpu)
 {
 	int &cpuNextEvent = cpu.cpuNextEvent;
 	int &cpuTotalTicks = cpu.cpuTotalTicks;
+	cpu.idleLoop.resetLoop();
   do {
 	  if (coreOptions.cheatsEnabled) {
 		  cpuMasterCodeCheck();
@@ -2195,6 +2196,9 @@ int thumbExecute(ARM7TDMI &cpu)
         clockTicks = codeTicksAccessSeq16(oldArmNextPC) + 1;
     cpuTotalTicks += clockTicks;
 
+    if (UNLIKELY(oldArmNextPC - armNextPC < cpu.idleLoop.maxBranchDistance))
+      cpuIdleLoopBranch(cpu, oldArmNextPC);
+
   } while (cpuTotalTicks < cpuNextEvent &&
   		(!CONFIG_TRIGGER_ARM_STATE_EVENT && !armState) && !cpu.SWITicks);
   return 1;
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 
 #include "core/base/port.h"
 #include "core/gba/gbaGlobals.h"
@@ -88,6 +89,59 @@ static inline void gfxClearArray(uint32_t* array)
 }
 
 #ifndef TILED_RENDERING
+// Text background tiles are drawn a row of 8 pixels at a time, with an all
+// transparent row stored directly
+
+static inline void gfxClearTileRow(uint32_t* dest)
+{
+  for (int i = 0; i < 8; i++)
+    dest[i] = 0x80000000;
+}
+
+// colors are palette indices, 0 being transparent
+static inline void gfxDrawTileRow(uint32_t* dest, const uint8_t colors[8], const uint16_t* palette, uint32_t prio)
+{
+  uint64_t anyColors;
+  memcpy(&anyColors, colors, sizeof(anyColors));
+  if (!anyColors) {
+    gfxClearTileRow(dest);
+    return;
+  }
+  for (int i = 0; i < 8; i++)
+    dest[i] = colors[i] ? (READ16LE(&palette[colors[i]]) | prio) : 0x80000000;
+}
+
+// 8 bytes of 256 color tile data
+static inline void gfxDrawTileRow256(uint32_t* dest, const uint8_t* tileRow, bool flipX, const uint16_t* palette, uint32_t prio)
+{
+  if (!flipX) {
+    gfxDrawTileRow(dest, tileRow, palette, prio);
+    return;
+  }
+  uint8_t colors[8];
+  for (int i = 0; i < 8; i++)
+    colors[i] = tileRow[7 - i];
+  gfxDrawTileRow(dest, colors, palette, prio);
+}
+
+// 4 bytes of 16 color tile data, low nibble first
+static inline void gfxDrawTileRow16(uint32_t* dest, const uint8_t* tileRow, bool flipX, const uint16_t* palette, uint32_t prio)
+{
+  uint8_t colors[8];
+  if (!flipX) {
+    for (int i = 0; i < 4; i++) {
+      colors[i * 2] = tileRow[i] & 0x0F;
+      colors[i * 2 + 1] = tileRow[i] >> 4;
+    }
+  } else {
+    for (int i = 0; i < 4; i++) {
+      colors[7 - i * 2] = tileRow[i] & 0x0F;
+      colors[6 - i * 2] = tileRow[i] >> 4;
+    }
+  }
+  gfxDrawTileRow(dest, colors, palette, prio);
+}
+
 static inline void gfxDrawTextScreen(uint8_t g_vram[0x20000], uint16_t control, uint16_t hofs, uint16_t vofs,
 				     uint32_t* line, const uint16_t VCOUNT, const uint16_t MOSAIC, const uint16_t *palette)
 {
@@ -126,103 +180,46 @@ static inline void gfxDrawTextScreen(uint8_t g_vram[0x20000], uint16_t control,
   }
 
   int yshift = ((yyy >> 3) << 5);
-  if ((control)&0x80) {
-    const uint16_t* screenSource = screenBase + 0x400 * (xxx >> 8) + ((xxx & 255) >> 3) + yshift;
-    for (int x = 0; x < 240; x++) {
-      uint16_t data = READ16LE(screenSource);
-
-      int tile = data & 0x3FF;
-      int tileX = (xxx & 7);
-      int tileY = yyy & 7;
-
-      if (tileX == 7)
-        screenSource++;
-
-      if (data & 0x0400)
-        tileX = 7 - tileX;
-      if (data & 0x0800)
-        tileY = 7 - tileY;
-
-      const size_t charBankOffset = tile * 64 + tileY * 8 + tileX;
-      const size_t charBankTotalOffset = charBankOffset + charBankBaseOffset;
-      uint8_t color;
+  int tileY = yyy & 7;
+  int columnMask = (sizeX >> 3) - 1;
+  int column = xxx >> 3;
+  int fineX = xxx & 7;
+  // draw whole tiles, starting at the one containing the first pixel, through a
+  // temporary line if the first tile is partly scrolled off screen
+  uint32_t tileLine[248];
+  uint32_t* dest = fineX ? tileLine : line;
+  int tiles = (fineX + 240 + 7) >> 3;
+  for (int t = 0; t < tiles; t++, dest += 8) {
+    uint16_t data = READ16LE(screenBase + 0x400 * (column >> 5) + (column & 31) + yshift);
+    column = (column + 1) & columnMask;
+
+    int tile = data & 0x3FF;
+    int rowY = (data & 0x0800) ? 7 - tileY : tileY;
+    bool flipX = data & 0x0400;
+
+    if ((control)&0x80) {
+      const size_t charBankTotalOffset = charBankBaseOffset + tile * 64 + rowY * 8;
       if (charBankTotalOffset >= 0x10000) {
           // Adapted from https://github.com/mgba-emu/mgba/commit/4ce9b83362ad66b1421afea7372adfc753bce97c
           // Real hardware PPU uses the most recently read from background
           // VRAM. This can't be easily emulated in vba-m, so we simply
           // use 0 here.
-          color = 0;
-      } else {
-          color = g_vram[charBankTotalOffset];
+          gfxClearTileRow(dest);
+          continue;
       }
-
-      line[x] = color ? (READ16LE(&palette[color]) | prio) : 0x80000000;
-
-      xxx++;
-      if (xxx == 256) {
-        if (sizeX > 256)
-          screenSource = screenBase + 0x400 + yshift;
-        else {
-          screenSource = screenBase + yshift;
-          xxx = 0;
-        }
-      } else if (xxx >= sizeX) {
-        xxx = 0;
-        screenSource = screenBase + yshift;
-      }
-    }
-  } else {
-    const uint16_t* screenSource = screenBase + 0x400 * (xxx >> 8) + ((xxx & 255) >> 3) + yshift;
-    for (int x = 0; x < 240; x++) {
-      uint16_t data = READ16LE(screenSource);
-
-      int tile = data & 0x3FF;
-      int tileX = (xxx & 7);
-      int tileY = yyy & 7;
-
-      if (tileX == 7)
-        screenSource++;
-
-      if (data & 0x0400)
-        tileX = 7 - tileX;
-      if (data & 0x0800)
-        tileY = 7 - tileY;
-
-      const size_t charBankOffset = (tile << 5) + (tileY << 2) + (tileX >> 1);
-      const size_t charBankTotalOffset = charBankOffset + charBankBaseOffset;
-      uint8_t color;
+      gfxDrawTileRow256(dest, &g_vram[charBankTotalOffset], flipX, palette, prio);
+    } else {
+      const size_t charBankTotalOffset = charBankBaseOffset + (tile << 5) + (rowY << 2);
       if (charBankTotalOffset >= 0x10000) {
-          // Adapted from https://github.com/mgba-emu/mgba/commit/4ce9b83362ad66b1421afea7372adfc753bce97c
-          // Real hardware PPU uses the most recently read from background
-          // VRAM. This can't be easily emulated in vba-m, so we simply
-          // use 0 here.
-          color = 0;
-      } else {
-         color = g_vram[charBankTotalOffset];
-      if (tileX & 1) {
-        color = (color >> 4);
-      } else {
-        color &= 0x0F;
-      }
+          gfxClearTileRow(dest);
+          continue;
       }
-
       int pal = (data >> 8) & 0xF0;
-      line[x] = color ? (READ16LE(&palette[pal + color]) | prio) : 0x80000000;
-
-      xxx++;
-      if (xxx == 256) {
-        if (sizeX > 256)
-          screenSource = screenBase + 0x400 + yshift;
-        else {
-          screenSource = screenBase + yshift;
-          xxx = 0;
-        }
-      } else if (xxx >= sizeX) {
-        xxx = 0;
-        screenSource = screenBase + yshift;
-      }
+      gfxDrawTileRow16(dest, &g_vram[charBankTotalOffset], flipX, palette + pal, prio);
     }
   }
+  if (fineX)
+    memcpy(line, tileLine + fineX, 240 * sizeof(uint32_t));
   if (mosaicOn) {
     if (mosaicX > 1) {
       int m = 1;
@@ -0,0 +1,165 @@
+#include "core/gba/gba.h"
+#include "core/gba/gbaCpu.h"
+#include "core/gba/gbaGlobals.h"
+
+// Idle loop detection, see GBAIdleLoopDetector in GBASys.hh.
+// A loop qualifies when its body can't write memory, change the CPU mode or leave
+// through an indirect jump, and the CPU state at the loop head is identical between
+// two consecutive iterations without any side-effecting reads in between. In that
+// case every following iteration is identical too until the next event, so whole
+// iterations can be skipped without changing emulation results.
+
+// Branches must stay inside the loop body, otherwise the checked instructions
+// aren't the only ones executed between iterations
+struct IdleLoopRange {
+    uint32_t loopPC, branchPC;
+
+    bool contains(uint32_t target) const { return target >= loopPC && target <= branchPC; }
+};
+
+static bool isIdleThumbOpcode(uint32_t opcode, uint32_t pc, IdleLoopRange range)
+{
+    switch (opcode >> 12) {
+    case 0x0: // shift by immediate
+    case 0x1: // add/subtract
+    case 0x2: // move/compare/add/subtract immediate
+    case 0x3:
+    case 0xA: // add to PC/SP
+        return true;
+    case 0x4:
+        if ((opcode & 0xFC00) == 0x4000) // ALU operations
+            return true;
+        if ((opcode & 0xFC00) == 0x4400) { // hi register operations
+            auto op = (opcode >> 8) & 3;
+            auto rd = (opcode & 7) | ((opcode >> 4) & 8);
+            return op == 1 || (op != 3 && rd != 15); // CMP, or ADD/MOV not writing PC, never BX
+        }
+        return true; // PC-relative load
+    case 0x5: // load/store with register offset
+        if (opcode & 0x0200) // sign-extended/halfword, only STRH stores
+            return (opcode & 0x0C00) != 0;
+        return opcode & 0x0800;
+    case 0x6: // load/store with immediate offset
+    case 0x7:
+    case 0x8: // load/store halfword
+    case 0x9: // SP-relative load/store
+        return opcode & 0x0800;
+    case 0xB: // only adjusting SP, push/pop touch the stack
+        return (opcode & 0xFF00) == 0xB000;
+    case 0xD: // conditional branch, excluding undefined & SWI
+        return (opcode & 0x0F00) < 0x0E00
+            && range.contains(pc + 4 + (int32_t(int8_t(opcode & 0xFF)) << 1));
+    case 0xE: // unconditional branch
+        return (opcode & 0x0800) == 0
+            && range.contains(pc + 4 + ((int32_t(opcode << 21) >> 21) << 1));
+    }
+    return false; // LDM/STM, BL
+}
+
+static bool isIdleArmOpcode(uint32_t opcode, uint32_t pc, IdleLoopRange range)
+{
+    if ((opcode >> 28) == 0xF)
+        return false;
+    auto rd = (opcode >> 12) & 0xF;
+    // post-indexed or write-back transfers also update the base register
+    bool writesPCBase = ((opcode >> 16) & 0xF) == 15 && (!(opcode & (1 << 24)) || (opcode & (1 << 21)));
+    switch ((opcode >> 25) & 7) {
+    case 0:
+        if ((opcode & 0x0FFFFFF0) == 0x012FFF10) // BX
+            return false;
+        if ((opcode & 0x0FC000F0) == 0x00000090) // MUL/MLA
+            return ((opcode >> 16) & 0xF) != 15;
+        if ((opcode & 0x0F8000F0) == 0x00800090) // long multiply
+            return true;
+        if ((opcode & 0x0FB00FF0) == 0x01000090) // SWP
+            return false;
+        if ((opcode & 0x90) == 0x90) // halfword/signed transfers
+            return (opcode & (1 << 20)) && rd != 15 && !writesPCBase;
+        if ((opcode & 0x0FBF0FFF) == 0x010F0000) // MRS
+            return true;
+        [[fallthrough]];
+    case 1:
+        if ((opcode & 0x0DB0F000) == 0x0120F000) // MSR
+            return false;
+        return rd != 15; // data processing
+    case 2:
+    case 3: // single data transfer
+        if ((opcode & 0x02000010) == 0x02000010) // undefined
+            return false;
+        return (opcode & (1 << 20)) && rd != 15 && !writesPCBase;
+    case 5: // branch without link
+        return (opcode & (1 << 24)) == 0
+            && range.contains(pc + 8 + ((int32_t(opcode << 8) >> 8) << 2));
+    }
+    return false; // LDM/STM including loading PC, coprocessor, SWI
+}
+
+static bool isIdleLoopBody(ARM7TDMI &cpu, uint32_t loopPC, uint32_t branchPC)
+{
+    auto& idle = cpu.idleLoop;
+    auto maxBytes = loopPC == idle.overrideLoopPC ? idle.maxOverrideLoopBytes : idle.maxLoopBytes;
+    if (branchPC - loopPC > maxBytes)
+        return false;
+    IdleLoopRange range{loopPC, branchPC};
+    if (cpu.armState) {
+        for (uint32_t pc = loopPC; pc <= branchPC; pc += 4) {
+            if (!isIdleArmOpcode(CPUReadMemoryQuick(cpu, pc), pc, range))
+                return false;
+        }
+    } else {
+        for (uint32_t pc = loopPC; pc <= branchPC; pc += 2) {
+            if (!isIdleThumbOpcode(CPUReadHalfWordQuick(cpu, pc), pc, range))
+                return false;
+        }
+    }
+    return true;
+}
+
+static GBAIdleLoopDetector::CPUState idleLoopState(const ARM7TDMI &cpu)
+{
+    GBAIdleLoopDetector::CPUState state;
+    for (int i = 0; i < 16; i++)
+        state.reg[i] = cpu.reg[i].I;
+    state.flags = (cpu.nFlag() << 3) | (cpu.zFlag() << 2) | (cpu.C_FLAG << 1) | cpu.V_FLAG | (cpu.busPrefetch << 4);
+    state.prefetchCount = cpu.busPrefetchCount;
+#ifdef VBAM_USE_CPU_PREFETCH
+    state.cpuPrefetch[0] = cpu.cpuPrefetch[0];
+    state.cpuPrefetch[1] = cpu.cpuPrefetch[1];
+#endif
+    return state;
+}
+
+void cpuIdleLoopBranch(ARM7TDMI &cpu, uint32_t branchPC)
+{
+    auto& idle = cpu.idleLoop;
+    uint32_t loopPC = cpu.armNextPC;
+    if (loopPC != idle.loopPC || branchPC != idle.loopBranchPC) {
+        idle.loopPC = loopPC;
+        idle.loopBranchPC = branchPC;
+        idle.loopIsIdleCandidate = isIdleLoopBody(cpu, loopPC, branchPC);
+        idle.loopState = idleLoopState(cpu);
+        idle.loopStartTicks = cpu.cpuTotalTicks;
+        idle.volatileRead = false;
+        return;
+    }
+    if (!idle.loopIsIdleCandidate)
+        return;
+    auto state = idleLoopState(cpu);
+    if (idle.volatileRead || state != idle.loopState) {
+        idle.loopState = state;
+        idle.loopStartTicks = cpu.cpuTotalTicks;
+        idle.volatileRead = false;
+        return;
+    }
+    int iterationTicks = cpu.cpuTotalTicks - idle.loopStartTicks;
+    if (iterationTicks > 0) {
+        // stop one iteration short of the event so it's reached at the same tick as without skipping
+        int iterations = (cpu.cpuNextEvent - 1 - cpu.cpuTotalTicks) / iterationTicks;
+        if (iterations > 0) {
+            int ticks = iterations * iterationTicks;
+            cpu.cpuTotalTicks += ticks;
+            idle.skippedTicks += ticks;
+        }
+    }
+    idle.loopStartTicks = cpu.cpuTotalTicks;
+}
@@ -217,9 +217,11 @@ static inline uint32_t CPUReadMemory(ARM7TDMI &cpu, uint32_t address)
         if ((address < 0x4000400) && ioReadable[address & 0x3fc]) {
             if (ioReadable[(address & 0x3fc) + 2]) {
                 value = READ32LE(((uint32_t*)&g_ioMem[address & 0x3fC]));
-                if ((address & 0x3fc) == COMM_JOY_RECV_L)
+                if ((address & 0x3fc) == COMM_JOY_RECV_L) {
+                    cpu.idleLoop.volatileRead = true;
                     UPDATE_REG(gba, COMM_JOYSTAT,
                         READ16LE(&g_ioMem[COMM_JOYSTAT]) & ~JOYSTAT_RECV);
+                }
             } else {
                 value = READ16LE(((uint16_t*)&g_ioMem[address & 0x3fc]));
             }
@@ -258,8 +260,10 @@ static inline uint32_t CPUReadMemory(ARM7TDMI &cpu, uint32_t address)
         }
         break;
     case REGION_ROM2EX:
-        if (cpuEEPROMEnabled)
+        if (cpuEEPROMEnabled) {
+            cpu.idleLoop.volatileRead = true;
             return eepromRead(address);
+        }
         goto unreadable;
     case REGION_SRAM:
     case REGION_SRAMEX:
@@ -376,6 +380,7 @@ static inline uint32_t CPUReadHalfWord(ARM7TDMI &cpu, uint32_t address)
             case IO_REG_SOUND4CNT_H: value &= 0x40FF; break;
             }
             if (((address & 0x3fe) > 0xFF) && ((address & 0x3fe) < 0x10E)) {
+                cpu.idleLoop.volatileRead = true;
                 if (((address & 0x3fe) == IO_REG_TM0CNT_L) && timer0On)
                     value = 0xFFFF - ((timer0Ticks - cpuTotalTicks) >> timer0ClockReload);
                 else if (((address & 0x3fe) == IO_REG_TM1CNT_L) && timer1On && !(TM1CNT & 4))
@@ -412,8 +417,10 @@ static inline uint32_t CPUReadHalfWord(ARM7TDMI &cpu, uint32_t address)
     case REGION_ROM1:
     case REGION_ROM1EX:
     case REGION_ROM2:
-    	  if (IsGPIO(address))
+    	  if (IsGPIO(address)) {
+            cpu.idleLoop.volatileRead = true;
             value = rtcRead(*cpu.gba, address);
+        }
         else if (IsEEPROM(address))
             return 0; // ignore reads from eeprom region outside 0x0D page reads
         else if ((address & 0x01FFFFFE) <= (gbaGetRomSize() - 2))
@@ -422,8 +429,10 @@ static inline uint32_t CPUReadHalfWord(ARM7TDMI &cpu, uint32_t address)
             value = (uint16_t)ROMReadOOB(address & 0x01FFFFFE);
         break;
     case REGION_ROM2EX:
-        if (cpuEEPROMEnabled)
+        if (cpuEEPROMEnabled) {
+            cpu.idleLoop.volatileRead = true;
             return eepromRead(address);
+        }
         goto unreadable;
     case REGION_SRAM:
     case REGION_SRAMEX:
@@ -549,8 +558,10 @@ static inline uint8_t CPUReadByte(ARM7TDMI &cpu, uint32_t address)
         else
             return (uint8_t)ROMReadOOB(address & 0x01FFFFFE);
     case REGION_ROM2EX:
-        if (cpuEEPROMEnabled)
+        if (cpuEEPROMEnabled) {
+            cpu.idleLoop.volatileRead = true;
             return DowncastU8(eepromRead(address));
+        }
         goto unreadable;
     case REGION_SRAM:
     case REGION_SRAMEX:
@@ -637,6 +648,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
             goto unwritable;
         break;
     case REGION_PRAM:
+        gba.lineRenderer.wait();
 #ifdef VBAM_ENABLE_DEBUGGER
         if (*((uint32_t*)&freezePRAM[address & 0x3fc]))
             cheatsWriteMemory(address & 0x70003FC, value);
@@ -645,6 +657,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
             WRITE32LE(((uint32_t*)&g_paletteRAM[address & 0x3FC]), value);
         break;
     case REGION_VRAM:
+        gba.lineRenderer.wait();
         address = (address & 0x1fffc);
         if (((DISPCNT & 7) > 2) && ((address & 0x1C000) == 0x18000))
             return;
@@ -660,6 +673,7 @@ static inline void CPUWriteMemory(ARM7TDMI &cpu, uint32_t address, uint32_t valu
             WRITE32LE(((uint32_t*)&g_vram[address]), value);
         break;
     case REGION_OAM:
+        gba.lineRenderer.wait();
 #ifdef VBAM_ENABLE_DEBUGGER
         if (*((uint32_t*)&freezeOAM[address & 0x3fc]))
             cheatsWriteMemory(address & 0x70003FC, value);
@@ -752,6 +766,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
             goto unwritable;
         break;
     case REGION_PRAM:
+        gba.lineRenderer.wait();
 #ifdef VBAM_ENABLE_DEBUGGER
         if (*((uint16_t*)&freezePRAM[address & 0x03fe]))
             cheatsWriteHalfWord(address & 0x70003fe, value);
@@ -760,6 +775,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
             WRITE16LE(((uint16_t*)&g_paletteRAM[address & 0x3fe]), value);
         break;
     case REGION_VRAM:
+        gba.lineRenderer.wait();
         address = (address & 0x1fffe);
         if (((DISPCNT & 7) > 2) && ((address & 0x1C000) == 0x18000))
             return;
@@ -773,6 +789,7 @@ static inline void CPUWriteHalfWord(ARM7TDMI &cpu, uint32_t address, uint16_t va
             WRITE16LE(((uint16_t*)&g_vram[address]), value);
         break;
     case REGION_OAM:
+        gba.lineRenderer.wait();
 #ifdef VBAM_ENABLE_DEBUGGER
         if (*((uint16_t*)&freezeOAM[address & 0x03fe]))
             cheatsWriteHalfWord(address & 0x70003fe, value);
@@ -930,10 +947,12 @@ static inline void CPUWriteByte(ARM7TDMI &cpu, uint32_t address, uint8_t b)
             goto unwritable;
         break;
     case REGION_PRAM:
+        gba.lineRenderer.wait();
         // no need to switch
         *((uint16_t*)&g_paletteRAM[address & 0x3FE]) = (b << 8) | b;
         break;
     case REGION_VRAM:
+        gba.lineRenderer.wait();
         address = (address & 0x1fffe);
         if (((DISPCNT & 7) > 2) && ((address & 0x1C000) == 0x18000))
             return;
@@ -952,6 +971,7 @@ static inline void CPUWriteByte(ARM7TDMI &cpu, uint32_t address, uint8_t b)
         }
         break;
     case REGION_OAM:
+        gba.lineRenderer.wait();
         break;
     case REGION_ROM2EX:
         if (cpuEEPROMEnabled) {
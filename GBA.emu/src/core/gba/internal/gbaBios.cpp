@@ -865,6 +865,7 @@ void BIOS_RegisterRamReset(ARM7TDMI &cpu, uint32_t flags)
       // clear internal RAM
     	memset(g_internalRAM, 0, 0x7e00); // don't clear 0x7e00-0x7fff
     }
+    cpu.gba->lineRenderer.wait();
     cpu.gba->lcd.registerRamReset(flags);
     /*
     if (flags & 0x04) {
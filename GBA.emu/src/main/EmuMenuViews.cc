@@ -394,6 +394,40 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
 		}
 	};
 
+	BoolMenuItem skipIdleLoops
+	{
+		"Skip Idle Loops", attachParams(),
+		system().skipIdleLoops,
+		[this](BoolMenuItem &item)
+		{
+			system().setSkipIdleLoops(item.flipBoolValue(*this));
+		}
+	};
+
+	BoolMenuItem threadedLineRendering
+	{
+		"Render Lines On Worker Thread", attachParams(),
+		system().threadedLineRendering,
+		[this](BoolMenuItem &item)
+		{
+			system().setThreadedLineRendering(item.flipBoolValue(*this));
+		}
+	};
+
+	TextMenuItem compareLineRendering
+	{
+		"Compare Worker Thread Line Output", attachParams(),
+		[this]
+		{
+			constexpr int frames = 120;
+			auto _ = app().suspendEmulationThread();
+			if(auto frame = system().findThreadedLineRenderingMismatch(app(), frames))
+				app().postErrorMessage(4, std::format("Worker thread output differs at frame {}", *frame));
+			else
+				app().postMessage(std::format("Worker thread output matches for {} frames", frames));
+		}
+	};
+
 	#ifdef IG_CONFIG_SENSORS
 	TextMenuItem lightSensorScaleItem[5]
 	{
@@ -441,6 +475,13 @@ public:
 	{
 		loadStockItems();
 		item.emplace_back(&bios);
+		item.emplace_back(&skipIdleLoops);
+		if(appContext().cpuCount() > 1)
+		{
+			item.emplace_back(&threadedLineRendering);
+			if(system().hasContent())
+				item.emplace_back(&compareLineRendering);
+		}
 		#ifdef IG_CONFIG_SENSORS
 		item.emplace_back(&lightSensorScale);
 		#endif
@@ -6,6 +6,10 @@
 #include <imagine/util/used.hh>
 #include <imagine/util/utility.hh>
 #include <imagine/util/memory/Buffer.hh>
+#include <imagine/vmem/memory.hh>
+#include <imagine/util/container/RingBuffer.hh>
+#include <imagine/thread/Thread.hh>
+#include <thread>
 
 using MixColorType = uint16_t;
 struct GBALCD;
@@ -195,7 +199,8 @@ struct GBAMem
 	IoMem ioMem;
 	uint8_t internalRAM[0x8000] __attribute__ ((aligned(4)));
 	uint8_t workRAM[0x40000] __attribute__ ((aligned(4)));
-	uint8_t rom[0x2000000] __attribute__ ((aligned(4)));
+	uint8_t *rom{}; // SIZE_ROM bytes from romStorage
+	IG::UniqueVPtr<uint8_t> romStorage;
 	IG::ByteBuffer rom2;
 };
 
@@ -327,6 +332,45 @@ struct GBALCD
 	}
 };
 
+// Renders lines on a worker thread while the CPU emulates ahead. Each queued line carries
+// a copy of the display registers it's drawn with and the emulation thread calls wait()
+// before changing any other renderer input (VRAM, palette, OAM, display registers and
+// the GBALCD state derived from them), so output matches rendering each line in place.
+class GBALineRenderer
+{
+public:
+	static constexpr size_t displayRegsSize = 0x58; // DISPCNT through COLY
+
+	GBALineRenderer() = default;
+	~GBALineRenderer() { stop(); }
+	void start(GBALCD &);
+	void stop();
+	bool isStarted() const { return thread.joinable(); }
+	void renderLine(GBALCD &, const GBAMem::IoMem &);
+	IG::ThreadId threadId() const { return threadId_; }
+
+	void wait()
+	{
+		if(!hasQueuedLines)
+			return;
+		jobs.waitForSize(0);
+		hasQueuedLines = false;
+	}
+
+private:
+	struct LineJob
+	{
+		GBALCD::RenderLineFunc renderLine{};
+		MixColorType *lineMix{};
+		std::array<uint8_t, displayRegsSize> displayRegs{};
+	};
+
+	IG::RingBuffer<LineJob, {.fixedSize = 256}> jobs;
+	std::thread thread;
+	IG::ThreadId threadId_{};
+	bool hasQueuedLines{};
+};
+
 struct ARM7TDMI;
 
 const char *dispModeName(GBALCD::RenderLineFunc);
@@ -376,6 +420,46 @@ typedef struct GBAMatrix {
 
 inline constexpr bool CONFIG_TRIGGER_ARM_STATE_EVENT = 0;
 
+// Detects short backward branch loops that only poll memory without side effects.
+// Once the CPU state at the loop head repeats exactly, the remaining whole iterations
+// before the next scheduled event are skipped by advancing the tick count.
+struct GBAIdleLoopDetector
+{
+	static constexpr uint32_t maxLoopBytes = 32;
+	static constexpr uint32_t maxOverrideLoopBytes = 64;
+
+	struct CPUState
+	{
+		std::array<uint32_t, 16> reg{};
+		uint32_t flags{};
+		uint32_t prefetchCount{};
+		uint32_t cpuPrefetch[2]{};
+
+		constexpr bool operator==(const CPUState&) const = default;
+	};
+
+	// backward branches with a larger distance skip the check entirely, 0 disables detection
+	uint32_t maxBranchDistance{};
+	uint32_t overrideLoopPC{};
+	uint32_t loopPC{};
+	uint32_t loopBranchPC{};
+	int loopStartTicks{};
+	bool loopIsIdleCandidate{};
+	bool volatileRead{};
+	CPUState loopState;
+	uint64_t skippedTicks{};
+
+	constexpr void setEnabled(bool on, uint32_t overridePC = 0)
+	{
+		overrideLoopPC = overridePC;
+		maxBranchDistance = on ? (overridePC ? maxOverrideLoopBytes : maxLoopBytes) + 1 : 0;
+		resetLoop();
+	}
+
+	constexpr bool isEnabled() const { return maxBranchDistance; }
+	constexpr void resetLoop() { loopPC = 0; }
+};
+
 struct ARM7TDMI
 {
 	constexpr ARM7TDMI(GBASys *gba): gba(gba) {}
@@ -427,6 +511,7 @@ public:
 	  {0, 0, 5, 0, 0, 1, 1, 0, 5, 5, 9, 9, 17, 17, 4, 0};
 	std::array<memoryMap, 256> map{};
 	GBAMatrix_t matrix;
+	GBAIdleLoopDetector idleLoop;
 
 	static constexpr bool calcNFlag(auto result)
 	{
@@ -661,6 +746,7 @@ struct GBASys
 	ARM7TDMI cpu{this};
 	uint8_t biosProtected[4]{};
 	GBALCD lcd;
+	GBALineRenderer lineRenderer;
 	GBATimers timers;
 	GBADMA dma;
 	GBAMem mem;
@@ -44,6 +44,23 @@ constexpr GameSettings settings[]
 #include "gba-over.inc"
 };
 
+// Known idle loops longer than automatic detection accepts, a loop address of 0 disables detection for the game
+struct IdleLoopOverride
+{
+	std::string_view gameId;
+	uint32_t loopPC;
+};
+
+constexpr IdleLoopOverride idleLoopOverrides[]
+{
+	{"AWRE", 0x8038810}, // Advance Wars (USA)
+	{"AWRP", 0x8038810}, // Advance Wars (Europe)
+	{"AGSE", 0x8013332}, // Golden Sun (USA)
+	{"AMTE", 0x80002C8}, // Metroid Fusion (USA)
+	{"AZCE", 0x80004E8}, // Mega Man Zero (USA)
+	{"AX4E", 0x800072A}, // Super Mario Advance 4 (USA)
+};
+
 namespace EmuEx
 {
 
@@ -132,6 +149,7 @@ WallClockTimePoint GbaSystem::backupMemoryLastWriteTime(const EmuApp &app) const
 void GbaSystem::closeSystem()
 {
 	assume(hasContent());
+	gGba.lineRenderer.stop();
 	CPUCleanUp();
 	saveFileIO = {};
 	coreOptions.saveType = GBA_SAVE_NONE;
@@ -140,6 +158,9 @@ void GbaSystem::closeSystem()
 	sensorListener = {};
 	darknessLevel = darknessLevelDefault;
 	cheatsList.clear();
+	if(gGba.cpu.idleLoop.skippedTicks)
+		log.info("skipped {} idle loop cycles", gGba.cpu.idleLoop.skippedTicks);
+	gGba.cpu.idleLoop.skippedTicks = 0;
   gGba.cpu.matrix = {};
   gGba.mem.rom2.reset();
 }
@@ -180,6 +201,11 @@ void GbaSystem::applyGamePatches(uint8_t *rom, int &romSize)
 void GbaSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate)
 {
 	coreOptions.cpuIsMultiBoot = endsWithAnyCaseless(contentFileName(), ".mb");
+	resetVPtr(gGba.mem.romStorage);
+	gGba.mem.romStorage = makeGuestMemory(SIZE_ROM);
+	if(!gGba.mem.romStorage)
+		throw std::bad_alloc();
+	gGba.mem.rom = gGba.mem.romStorage.get();
 	int size = CPULoadRomWithIO(gGba, io, coreOptions.cpuIsMultiBoot ? LoadDestination::ram : LoadDestination::rom);
 	if(!size)
 	{
@@ -187,6 +213,8 @@ void GbaSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 	}
 	setGameSpecificSettings(gGba, size);
 	applyGamePatches(gGba.mem.rom, size);
+	applyGuestMemoryFlags(gGba.mem.workRAM);
+	applyGuestMemoryFlags(gGba.lcd.vram);
 	ByteBuffer biosRom;
 	if(shouldUseBios())
 	{
@@ -197,6 +225,8 @@ void GbaSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegat
 	CPUInit(gGba, biosRom);
 	CPUReset(gGba);
 	readCheatFile();
+	if(lineRenderingThreadEnabled())
+		gGba.lineRenderer.start(gGba.lcd);
 }
 
 static void updateColorMap(auto &map, const PixelDesc &pxDesc)
@@ -316,6 +346,16 @@ void GbaSystem::setGameSpecificSettings(GBASys &gba, int romSize)
 		setSaveType(detectedSaveType, detectedSaveSize);
 	}
 	setRTC(optionRtcEmulation);
+	idleLoopOverridePC = 0;
+	idleLoopSkipDisabled = false;
+	if(auto it = std::ranges::find_if(idleLoopOverrides, [&](const auto &o){return o.gameId == gameId;});
+		it != std::end(idleLoopOverrides))
+	{
+		idleLoopOverridePC = it->loopPC;
+		idleLoopSkipDisabled = !it->loopPC;
+		log.info("idle loop override:{:X}", it->loopPC);
+	}
+	gba.cpu.idleLoop.setEnabled(idleLoopSkipEnabled(), idleLoopOverridePC);
 }
 
 void GbaSystem::setSensorActive(bool on)
@@ -386,6 +426,7 @@ void systemDrawScreen(const GBALCD& lcd, EmuEx::EmuSystemTaskContext taskCtx, Em
 		assume(img.pixmap().format().bytesPerPixel() == 4);
 		img.pixmap().writeTransformed([&](uint16_t p){ return lcd.systemColorMap.map32[p]; }, framePix);
 	}
+	video.addCopiedBytes(img.pixmap().unpaddedBytes());
 	img.endFrame();
 }
 
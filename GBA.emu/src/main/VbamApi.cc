@@ -188,7 +188,7 @@ void preLoadRomSetup(GBASys &gba)
 {
 	systemSaveUpdateCounter = SYSTEM_SAVE_NOT_UPDATED;
 	memset(gba.mem.workRAM, 0, sizeof(gba.mem.workRAM));
-	memset(gba.mem.rom, 0, sizeof(gba.mem.rom));
+	// ROM memory is freshly allocated and zeroed before each load
 }
 
 void postLoadRomSetup(GBASys &gba)
@@ -362,3 +362,60 @@ const char *dispModeName(GBALCD::RenderLineFunc renderLine)
 	else if (renderLine == mode5RenderLineAll) return "5A";
 	else return "Invalid";
 }
+
+void GBALineRenderer::start(GBALCD &lcd)
+{
+	if(isStarted())
+		return;
+	thread = makeThreadSync([this, &lcd](auto &sem)
+	{
+		threadId_ = thisThreadId();
+		sem.release();
+		GbaSystem::log.info("started line render thread");
+		GBAMem::IoMem ioMem{};
+		while(true)
+		{
+			auto span = jobs.beginRead(1, {.blocking = true});
+			if(!span.size())
+				continue;
+			auto &job = span[0];
+			if(!job.renderLine) [[unlikely]]
+			{
+				jobs.endRead(span);
+				jobs.notifyRead();
+				break;
+			}
+			std::ranges::copy(job.displayRegs, ioMem.b);
+			job.renderLine(job.lineMix, lcd, ioMem);
+			// only mark the line as read once it's drawn so wait() also covers the current line
+			jobs.endRead(span);
+			jobs.notifyRead();
+		}
+		GbaSystem::log.info("stopped line render thread");
+	});
+}
+
+void GBALineRenderer::stop()
+{
+	if(!isStarted())
+		return;
+	jobs.push({}, {.blocking = true});
+	jobs.notifyWrite();
+	thread.join();
+	jobs.clear();
+	threadId_ = {};
+	hasQueuedLines = false;
+}
+
+void GBALineRenderer::renderLine(GBALCD &lcd, const GBAMem::IoMem &ioMem)
+{
+	if(!isStarted())
+	{
+		lcd.renderLine(lcd.lineMix, lcd, ioMem);
+		return;
+	}
+	LineJob job{lcd.renderLine, lcd.lineMix};
+	std::copy_n(ioMem.b, displayRegsSize, job.displayRegs.data());
+	jobs.push(job, {.blocking = true, .flushSize = 8});
+	hasQueuedLines = true;
+}
@@ -49,6 +49,8 @@ bool GbaSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_PATCHES_PATH: return readStringOptionValue(io, patchesDir);
 			case CFGKEY_BIOS_PATH: return readStringOptionValue(io, biosPath);
 			case CFGKEY_DEFAULT_USE_BIOS: return readOptionValue(io, defaultUseBios);
+			case CFGKEY_SKIP_IDLE_LOOPS: return readOptionValue(io, skipIdleLoops);
+			case CFGKEY_THREADED_LINE_RENDERING: return readOptionValue(io, threadedLineRendering);
 		}
 	}
 	else if(type == ConfigType::SESSION)
@@ -78,6 +80,8 @@ void GbaSystem::writeConfig(ConfigType type, FileIO &io)
 		writeStringOptionValue(io, CFGKEY_PATCHES_PATH, patchesDir);
 		writeStringOptionValue(io, CFGKEY_BIOS_PATH, biosPath);
 		writeOptionValueIfNotDefault(io, defaultUseBios);
+		writeOptionValueIfNotDefault(io, skipIdleLoops);
+		writeOptionValueIfNotDefault(io, threadedLineRendering);
 	}
 	else if(type == ConfigType::SESSION)
 	{
@@ -103,6 +107,58 @@ void GbaSystem::setRTC(RtcMode mode)
 	}
 }
 
+void GbaSystem::setSkipIdleLoops(bool on)
+{
+	skipIdleLoops = on;
+	gGba.cpu.idleLoop.setEnabled(idleLoopSkipEnabled(), idleLoopOverridePC);
+}
+
+void GbaSystem::setThreadedLineRendering(bool on)
+{
+	threadedLineRendering = on;
+	if(!hasContent())
+		return;
+	if(lineRenderingThreadEnabled())
+		gGba.lineRenderer.start(gGba.lcd);
+	else
+		gGba.lineRenderer.stop();
+}
+
+// Runs frames from the current state with lines rendered in place and then on the worker thread,
+// returning the first frame whose hash differs, then restores the state
+std::optional<int> GbaSystem::findThreadedLineRenderingMismatch(EmuApp &app, int frames)
+{
+	auto &video = app.video;
+	DynArray<uint8_t> state{stateSize()};
+	std::span<uint8_t> stateSpan{state.data(), writeState(state, {.uncompressed = true})};
+	auto runFramesWithHashes = [&]
+	{
+		std::vector<uint64_t> hashes(frames);
+		for(auto &hash : hashes)
+		{
+			video.requestFrameHash();
+			runFrame({}, &video, nullptr);
+			hash = video.frameHash;
+		}
+		return hashes;
+	};
+	bool wasStarted = gGba.lineRenderer.isStarted();
+	gGba.lineRenderer.stop();
+	auto inPlaceHashes = runFramesWithHashes();
+	readState(app, stateSpan);
+	gGba.lineRenderer.start(gGba.lcd);
+	auto threadedHashes = runFramesWithHashes();
+	readState(app, stateSpan);
+	if(!wasStarted)
+		gGba.lineRenderer.stop();
+	auto [inPlaceIt, threadedIt] = std::ranges::mismatch(inPlaceHashes, threadedHashes);
+	if(inPlaceIt == inPlaceHashes.end())
+		return {};
+	log.error("threaded line rendering frame:{} hash:{:016x} doesn't match in place hash:{:016x}",
+		inPlaceIt - inPlaceHashes.begin(), *threadedIt, *inPlaceIt);
+	return int(inPlaceIt - inPlaceHashes.begin());
+}
+
 void GbaSystem::setSensorType(GbaSensorType type)
 {
 	sensorType = type;
@@ -69,6 +69,13 @@ public:
 	  */
 	virtual std::size_t resample(short *out, short const *in, std::size_t inlen) = 0;
 
+	/**
+	  * Returns how many of the most recent input samples still affect the output.
+	  * Feeding that many samples to a new resampler brings it to the same state
+	  * as one that has been running on the same input.
+	  */
+	virtual std::size_t historyLength() const = 0;
+
 	virtual ~Resampler() {}
 
 protected:
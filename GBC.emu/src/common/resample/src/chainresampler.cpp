@@ -198,6 +198,18 @@ void ChainResampler::exactRatio(unsigned long &mul, unsigned long &div) const {
 	}
 }
 
+std::size_t ChainResampler::historyLength() const {
+	// each stage's history is in samples of its own input rate, scale it back to the chain's input
+	double len = 0;
+	double inPerStageIn = 1;
+	for (List::const_iterator it = list_.begin(); it != list_.end(); ++it) {
+		len += (*it)->historyLength() * inPerStageIn;
+		inPerStageIn *= static_cast<double>((*it)->div()) / (*it)->mul();
+	}
+
+	return static_cast<std::size_t>(std::ceil(len));
+}
+
 std::size_t ChainResampler::resample(short *const out, short const *const in, std::size_t inlen) {
 	assert(inlen <= periodSize_);
 	short *const buf = buffer_ != buffer2_ ? buffer_ : out;
@@ -40,6 +40,7 @@ public:
 	virtual void exactRatio(unsigned long &mul, unsigned long &div) const;
 	virtual std::size_t maxOut(std::size_t /*inlen*/) const { return maxOut_; }
 	virtual std::size_t resample(short *out, short const *in, std::size_t inlen);
+	virtual std::size_t historyLength() const;
 
 private:
 	typedef std::list<SubResampler *> List;
@@ -19,10 +19,11 @@
 #ifndef CIC2_H
 #define CIC2_H
 
+#include "cicsum.h"
 #include "rshift16_round.h"
 #include "subresampler.h"
 
-template<unsigned channels>
+template<unsigned channels, class Sum = CicSum<1> >
 class Cic2Core {
 public:
 	explicit Cic2Core(unsigned div = 2) { reset(div); }
@@ -35,9 +36,9 @@ public:
 	}
 
 private:
-	unsigned long sum1_;
-	unsigned long sum2_;
-	unsigned long prev1_;
+	Sum sum1_;
+	Sum sum2_;
+	Sum prev1_;
 	unsigned div_;
 	unsigned nextdivn_;
 
@@ -45,35 +46,35 @@ private:
 	static long mulForDiv(unsigned div) { return 0x10000 / (div * div); }
 };
 
-template<unsigned channels>
-void Cic2Core<channels>::reset(unsigned div) {
-	sum2_ = sum1_ = 0;
-	prev1_ = 0;
+template<unsigned channels, class Sum>
+void Cic2Core<channels, Sum>::reset(unsigned div) {
+	sum2_ = sum1_ = Sum();
+	prev1_ = Sum();
 	div_ = div;
 	nextdivn_ = div;
 }
 
-template<unsigned channels>
-std::size_t Cic2Core<channels>::filter(short *out, short const *const in, std::size_t inlen) {
+template<unsigned channels, class Sum>
+std::size_t Cic2Core<channels, Sum>::filter(short *out, short const *const in, std::size_t inlen) {
 	std::size_t const produced = (inlen + div_ - nextdivn_) / div_;
 	long const mul = mulForDiv(div_);
 	short const *s = in;
-	unsigned long sm1 = sum1_;
-	unsigned long sm2 = sum2_;
+	Sum sm1 = sum1_;
+	Sum sm2 = sum2_;
 
 	if (inlen >= nextdivn_) {
 		{
 			unsigned divn = nextdivn_;
 			do {
-				sm1 += static_cast<long>(*s);
+				sm1 += Sum::load(s);
 				s += channels;
 				sm2 += sm1;
 			} while (--divn);
 
-			unsigned long const out2 = sm2;
-			sm2 = 0;
+			Sum const out2 = sm2;
+			sm2 = Sum();
 
-			*out = rshift16_round(static_cast<long>(out2 - prev1_) * mul);
+			(out2 - prev1_).store(out, mul);
 			prev1_ = out2;
 			out += channels;
 		}
@@ -82,39 +83,39 @@ std::size_t Cic2Core<channels>::filter(short *out, short const *const in, std::s
 			for (std::size_t n = produced; --n;) {
 				unsigned divn = div_ >> 1;
 				do {
-					sm1 += static_cast<long>(*s);
+					sm1 += Sum::load(s);
 					s += channels;
 					sm2 += sm1;
-					sm1 += static_cast<long>(*s);
+					sm1 += Sum::load(s);
 					s += channels;
 					sm2 += sm1;
 				} while (--divn);
 
-				sm1 += static_cast<long>(*s);
+				sm1 += Sum::load(s);
 				s += channels;
 				sm2 += sm1;
 
-				*out = rshift16_round(static_cast<long>(sm2 - prev1_) * mul);
+				(sm2 - prev1_).store(out, mul);
 				out += channels;
 				prev1_ = sm2;
-				sm2 = 0;
+				sm2 = Sum();
 			}
 		} else {
 			for (std::size_t n = produced; --n;) {
 				unsigned divn = div_ >> 1;
 				do {
-					sm1 += static_cast<long>(*s);
+					sm1 += Sum::load(s);
 					s += channels;
 					sm2 += sm1;
-					sm1 += static_cast<long>(*s);
+					sm1 += Sum::load(s);
 					s += channels;
 					sm2 += sm1;
 				} while (--divn);
 
-				*out = rshift16_round(static_cast<long>(sm2 - prev1_) * mul);
+				(sm2 - prev1_).store(out, mul);
 				out += channels;
 				prev1_ = sm2;
-				sm2 = 0;
+				sm2 = Sum();
 			}
 		}
 
@@ -126,7 +127,7 @@ std::size_t Cic2Core<channels>::filter(short *out, short const *const in, std::s
 		nextdivn_ -= divn;
 
 		while (divn--) {
-			sm1 += static_cast<long>(*s);
+			sm1 += Sum::load(s);
 			s += channels;
 			sm2 += sm1;
 		}
@@ -146,23 +147,26 @@ public:
 	virtual std::size_t resample(short *out, short const *in, std::size_t inlen);
 	virtual unsigned mul() const { return 1; }
 	virtual unsigned div() const { return cics_[0].div(); }
+	virtual std::size_t historyLength() const { return 2 * div(); }
 	static double gain(unsigned div) { return Cic2Core<channels>::gain(div); }
 
 private:
-	Cic2Core<channels> cics_[channels];
+	// stereo is filtered in one pass with both channels in the same sums
+	enum { lanes = channels == 2 ? 2 : 1 };
+	Cic2Core<channels, CicSum<lanes> > cics_[channels / lanes];
 };
 
 template<unsigned channels>
 Cic2<channels>::Cic2(unsigned div) {
-	for (unsigned i = 0; i < channels; ++i)
+	for (unsigned i = 0; i < channels / lanes; ++i)
 		cics_[i].reset(div);
 }
 
 template<unsigned channels>
 std::size_t Cic2<channels>::resample(short *out, short const *in, std::size_t inlen) {
 	std::size_t samplesOut;
-	for (unsigned i = 0; i < channels; ++i)
-		samplesOut = cics_[i].filter(out + i, in + i, inlen);
+	for (unsigned i = 0; i < channels / lanes; ++i)
+		samplesOut = cics_[i].filter(out + i * lanes, in + i * lanes, inlen);
 
 	return samplesOut;
 }
@@ -19,10 +19,11 @@
 #ifndef CIC3_H
 #define CIC3_H
 
+#include "cicsum.h"
 #include "rshift16_round.h"
 #include "subresampler.h"
 
-template<unsigned channels>
+template<unsigned channels, class Sum = CicSum<1> >
 class Cic3Core {
 public:
 	explicit Cic3Core(unsigned div = 1) { reset(div); }
@@ -35,11 +36,11 @@ public:
 	}
 
 private:
-	unsigned long sum1_;
-	unsigned long sum2_;
-	unsigned long sum3_;
-	unsigned long prev1_;
-	unsigned long prev2_;
+	Sum sum1_;
+	Sum sum2_;
+	Sum sum3_;
+	Sum prev1_;
+	Sum prev2_;
 	unsigned div_;
 	unsigned nextdivn_;
 
@@ -47,21 +48,21 @@ private:
 	static long mulForDiv(unsigned div) { return 0x10000 / (div * div * div); }
 };
 
-template<unsigned channels>
-void Cic3Core<channels>::reset(unsigned div) {
-	sum3_ = sum2_ = sum1_ = 0;
-	prev2_ = prev1_ = 0;
+template<unsigned channels, class Sum>
+void Cic3Core<channels, Sum>::reset(unsigned div) {
+	sum3_ = sum2_ = sum1_ = Sum();
+	prev2_ = prev1_ = Sum();
 	div_ = div;
 	nextdivn_ = div;
 }
 
-template<unsigned channels>
-std::size_t Cic3Core<channels>::filter(short *out, short const *const in, std::size_t inlen) {
+template<unsigned channels, class Sum>
+std::size_t Cic3Core<channels, Sum>::filter(short *out, short const *const in, std::size_t inlen) {
 	std::size_t const produced = (inlen + div_ - nextdivn_) / div_;
 	short const *s = in;
-	unsigned long sm1 = sum1_;
-	unsigned long sm2 = sum2_;
-	unsigned long sm3 = sum3_;
+	Sum sm1 = sum1_;
+	Sum sm2 = sum2_;
+	Sum sm3 = sum3_;
 
 	if (inlen >= nextdivn_) {
 		long const mul = mulForDiv(div_);
@@ -70,19 +71,19 @@ std::size_t Cic3Core<channels>::filter(short *out, short const *const in, std::s
 
 		do {
 			do {
-				sm1 += static_cast<long>(*s);
+				sm1 += Sum::load(s);
 				sm2 += sm1;
 				sm3 += sm2;
 				s += channels;
 			} while (--divn);
 
-			unsigned long const out2 = sm3 - prev2_;
+			Sum const out2 = sm3 - prev2_;
 			prev2_ = sm3;
-			*out = rshift16_round(static_cast<long>(out2 - prev1_) * mul);
+			(out2 - prev1_).store(out, mul);
 			prev1_ = out2;
 			out += channels;
 			divn = div_;
-			sm3 = 0;
+			sm3 = Sum();
 		} while (--n);
 
 		nextdivn_ = div_;
@@ -93,7 +94,7 @@ std::size_t Cic3Core<channels>::filter(short *out, short const *const in, std::s
 		nextdivn_ -= divn;
 
 		while (divn--) {
-			sm1 += static_cast<long>(*s);
+			sm1 += Sum::load(s);
 			sm2 += sm1;
 			sm3 += sm2;
 			s += channels;
@@ -115,23 +116,26 @@ public:
 	virtual std::size_t resample(short *out, short const *in, std::size_t inlen);
 	virtual unsigned mul() const { return 1; }
 	virtual unsigned div() const { return cics_[0].div(); }
+	virtual std::size_t historyLength() const { return 3 * div(); }
 	static double gain(unsigned div) { return Cic3Core<channels>::gain(div); }
 
 private:
-	Cic3Core<channels> cics_[channels];
+	// stereo is filtered in one pass with both channels in the same sums
+	enum { lanes = channels == 2 ? 2 : 1 };
+	Cic3Core<channels, CicSum<lanes> > cics_[channels / lanes];
 };
 
 template<unsigned channels>
 Cic3<channels>::Cic3(unsigned div) {
-	for (unsigned i = 0; i < channels; ++i)
+	for (unsigned i = 0; i < channels / lanes; ++i)
 		cics_[i].reset(div);
 }
 
 template<unsigned channels>
 std::size_t Cic3<channels>::resample(short *out, short const *in, std::size_t inlen) {
 	std::size_t samplesOut;
-	for (unsigned i = 0; i < channels; ++i)
-		samplesOut = cics_[i].filter(out + i, in + i, inlen);
+	for (unsigned i = 0; i < channels / lanes; ++i)
+		samplesOut = cics_[i].filter(out + i * lanes, in + i * lanes, inlen);
 
 	return samplesOut;
 }
@@ -19,10 +19,11 @@
 #ifndef CIC4_H
 #define CIC4_H
 
+#include "cicsum.h"
 #include "rshift16_round.h"
 #include "subresampler.h"
 
-template<unsigned channels>
+template<unsigned channels, class Sum = CicSum<1> >
 class Cic4Core {
 public:
 	explicit Cic4Core(unsigned div = 1) { reset(div); }
@@ -36,15 +37,15 @@ public:
 
 private:
 	enum { buf_len = 64 };
-	unsigned long buf_[buf_len];
-	unsigned long sum1_;
-	unsigned long sum2_;
-	unsigned long sum3_;
-	unsigned long sum4_;
-	unsigned long prev1_;
-	unsigned long prev2_;
-	unsigned long prev3_;
-	unsigned long prev4_;
+	Sum buf_[buf_len];
+	Sum sum1_;
+	Sum sum2_;
+	Sum sum3_;
+	Sum sum4_;
+	Sum prev1_;
+	Sum prev2_;
+	Sum prev3_;
+	Sum prev4_;
 	unsigned div_;
 	unsigned bufpos_;
 
@@ -52,45 +53,45 @@ private:
 	static long mulForDiv(unsigned div) { return 0x10000 / (div * div * div * div); }
 };
 
-template<unsigned channels>
-void Cic4Core<channels>::reset(unsigned div) {
-	sum4_ = sum3_ = sum2_ = sum1_ = 0;
-	prev4_ = prev3_ = prev2_ = prev1_ = 0;
+template<unsigned channels, class Sum>
+void Cic4Core<channels, Sum>::reset(unsigned div) {
+	sum4_ = sum3_ = sum2_ = sum1_ = Sum();
+	prev4_ = prev3_ = prev2_ = prev1_ = Sum();
 	div_ = div;
 	bufpos_ = div - 1;
 }
 
-template<unsigned channels>
-std::size_t Cic4Core<channels>::filter(short *out, short const *const in, std::size_t inlen) {
+template<unsigned channels, class Sum>
+std::size_t Cic4Core<channels, Sum>::filter(short *out, short const *const in, std::size_t inlen) {
 	std::size_t const produced = (inlen + div_ - (bufpos_ + 1)) / div_;
 	long const mul = mulForDiv(div_);
 	short const *s = in;
 
-	unsigned long sm1 = sum1_;
-	unsigned long sm2 = sum2_;
-	unsigned long sm3 = sum3_;
-	unsigned long sm4 = sum4_;
-	unsigned long prv1 = prev1_;
-	unsigned long prv2 = prev2_;
-	unsigned long prv3 = prev3_;
-	unsigned long prv4 = prev4_;
+	Sum sm1 = sum1_;
+	Sum sm2 = sum2_;
+	Sum sm3 = sum3_;
+	Sum sm4 = sum4_;
+	Sum prv1 = prev1_;
+	Sum prv2 = prev2_;
+	Sum prv3 = prev3_;
+	Sum prv4 = prev4_;
 
 	while (inlen >> 2) {
 		unsigned const end = inlen < buf_len ? inlen & ~3 : buf_len & ~3;
-		unsigned long *b = buf_;
+		Sum *b = buf_;
 		unsigned n = end;
 
 		do {
-			unsigned long s1 = sm1 += static_cast<long>(s[0 * channels]);
-			sm1 += static_cast<long>(s[1 * channels]);
-			unsigned long s2 = sm2 += s1;
+			Sum s1 = sm1 += Sum::load(s + 0 * channels);
+			sm1 += Sum::load(s + 1 * channels);
+			Sum s2 = sm2 += s1;
 			sm2 += sm1;
-			unsigned long s3 = sm3 += s2;
+			Sum s3 = sm3 += s2;
 			sm3 += sm2;
 			b[0] = sm4 += s3;
 			b[1] = sm4 += sm3;
-			s1 = sm1 += static_cast<long>(s[2 * channels]);
-			sm1 += static_cast<long>(s[3 * channels]);
+			s1 = sm1 += Sum::load(s + 2 * channels);
+			sm1 += Sum::load(s + 3 * channels);
 			s2 = sm2 += s1;
 			sm2 += sm1;
 			s3 = sm3 += s2;
@@ -102,16 +103,16 @@ std::size_t Cic4Core<channels>::filter(short *out, short const *const in, std::s
 		} while (n -= 4);
 
 		while (bufpos_ < end) {
-			unsigned long const out4 = buf_[bufpos_] - prv4;
+			Sum const out4 = buf_[bufpos_] - prv4;
 			prv4 = buf_[bufpos_];
 			bufpos_ += div_;
 
-			unsigned long const out3 = out4 - prv3;
+			Sum const out3 = out4 - prv3;
 			prv3 = out4;
-			unsigned long const out2 = out3 - prv2;
+			Sum const out2 = out3 - prv2;
 			prv2 = out3;
 
-			*out = rshift16_round(static_cast<long>(out2 - prv1) * mul);
+			(out2 - prv1).store(out, mul);
 			prv1 = out2;
 			out += channels;
 		}
@@ -125,7 +126,7 @@ std::size_t Cic4Core<channels>::filter(short *out, short const *const in, std::s
 		unsigned i = 0;
 
 		do {
-			sm1 += static_cast<long>(*s);
+			sm1 += Sum::load(s);
 			s += channels;
 			sm2 += sm1;
 			sm3 += sm2;
@@ -133,16 +134,16 @@ std::size_t Cic4Core<channels>::filter(short *out, short const *const in, std::s
 		} while (--n);
 
 		while (bufpos_ < inlen) {
-			unsigned long const out4 = buf_[bufpos_] - prv4;
+			Sum const out4 = buf_[bufpos_] - prv4;
 			prv4 = buf_[bufpos_];
 			bufpos_ += div_;
 
-			unsigned long const out3 = out4 - prv3;
+			Sum const out3 = out4 - prv3;
 			prv3 = out4;
-			unsigned long const out2 = out3 - prv2;
+			Sum const out2 = out3 - prv2;
 			prv2 = out3;
 
-			*out = rshift16_round(static_cast<long>(out2 - prv1) * mul);
+			(out2 - prv1).store(out, mul);
 			prv1 = out2;
 			out += channels;
 		}
@@ -170,23 +171,26 @@ public:
 	virtual std::size_t resample(short *out, short const *in, std::size_t inlen);
 	virtual unsigned mul() const { return 1; }
 	virtual unsigned div() const { return cics_[0].div(); }
+	virtual std::size_t historyLength() const { return 4 * div(); }
 	static double gain(unsigned div) { return Cic4Core<channels>::gain(div); }
 
 private:
-	Cic4Core<channels> cics_[channels];
+	// stereo is filtered in one pass with both channels in the same sums
+	enum { lanes = channels == 2 ? 2 : 1 };
+	Cic4Core<channels, CicSum<lanes> > cics_[channels / lanes];
 };
 
 template<unsigned channels>
 Cic4<channels>::Cic4(unsigned div) {
-	for (unsigned i = 0; i < channels; ++i)
+	for (unsigned i = 0; i < channels / lanes; ++i)
 		cics_[i].reset(div);
 }
 
 template<unsigned channels>
 std::size_t Cic4<channels>::resample(short *out, short const *in, std::size_t inlen) {
 	std::size_t samplesOut;
-	for (unsigned i = 0; i < channels; ++i)
-		samplesOut = cics_[i].filter(out + i, in + i, inlen);
+	for (unsigned i = 0; i < channels / lanes; ++i)
+		samplesOut = cics_[i].filter(out + i * lanes, in + i * lanes, inlen);
 
 	return samplesOut;
 }
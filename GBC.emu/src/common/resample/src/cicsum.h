@@ -0,0 +1,120 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Sindre Aamås                                    *
+ *   sinamas@users.sourceforge.net                                         *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License version 2 as     *
+ *   published by the Free Software Foundation.                            *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License version 2 for more details.                *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   version 2 along with this program; if not, write to the               *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA  02110-1301, USA.             *
+ ***************************************************************************/
+#ifndef CICSUM_H
+#define CICSUM_H
+
+#include "rshift16_round.h"
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Integrator/comb state of a CIC filter for 'lanes' adjacent interleaved channels,
+// so all channels of a stereo stream can be filtered in a single pass.
+// The sums wrap around, which leaves the comb output exact as long as it fits the
+// sum type. For the supported divisors it's below 32768 * div^order < 2^31, so
+// 32 bit lanes give the same results as unsigned long.
+template<unsigned lanes>
+class CicSum;
+
+template<>
+class CicSum<1> {
+public:
+	CicSum() : v_(0) {}
+	static CicSum load(short const *s) { return CicSum(static_cast<long>(*s)); }
+	CicSum & operator+=(CicSum rhs) { v_ += rhs.v_; return *this; }
+	CicSum operator-(CicSum rhs) const { return CicSum(v_ - rhs.v_); }
+	void store(short *out, long mul) const { *out = rshift16_round(static_cast<long>(v_) * mul); }
+
+private:
+	unsigned long v_;
+
+	explicit CicSum(unsigned long v) : v_(v) {}
+};
+
+template<>
+class CicSum<2> {
+public:
+#if defined(__SSE2__)
+	CicSum() : v_(_mm_setzero_si128()) {}
+
+	static CicSum load(short const *s) {
+		int pair;
+		std::memcpy(&pair, s, sizeof pair);
+		__m128i v = _mm_cvtsi32_si128(pair);
+		return CicSum(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+	}
+
+	CicSum & operator+=(CicSum rhs) { v_ = _mm_add_epi32(v_, rhs.v_); return *this; }
+	CicSum operator-(CicSum rhs) const { return CicSum(_mm_sub_epi32(v_, rhs.v_)); }
+
+	void store(short *out, long mul) const {
+		storeLanes(out, _mm_cvtsi128_si32(v_), _mm_cvtsi128_si32(_mm_srli_si128(v_, 4)), mul);
+	}
+
+private:
+	__m128i v_;
+
+	explicit CicSum(__m128i v) : v_(v) {}
+#elif defined(__ARM_NEON)
+	CicSum() : v_(vdup_n_s32(0)) {}
+
+	static CicSum load(short const *s) {
+		int16x4_t v = vld1_lane_s16(s + 1, vld1_dup_s16(s), 1);
+		return CicSum(vget_low_s32(vmovl_s16(v)));
+	}
+
+	CicSum & operator+=(CicSum rhs) { v_ = vadd_s32(v_, rhs.v_); return *this; }
+	CicSum operator-(CicSum rhs) const { return CicSum(vsub_s32(v_, rhs.v_)); }
+	void store(short *out, long mul) const { storeLanes(out, vget_lane_s32(v_, 0), vget_lane_s32(v_, 1), mul); }
+
+private:
+	int32x2_t v_;
+
+	explicit CicSum(int32x2_t v) : v_(v) {}
+#else
+	CicSum() : l_(0), r_(0) {}
+	static CicSum load(short const *s) { return CicSum(s[0], s[1]); }
+
+	CicSum & operator+=(CicSum rhs) {
+		l_ += rhs.l_;
+		r_ += rhs.r_;
+		return *this;
+	}
+
+	CicSum operator-(CicSum rhs) const { return CicSum(l_ - rhs.l_, r_ - rhs.r_); }
+	void store(short *out, long mul) const { storeLanes(out, static_cast<int>(l_), static_cast<int>(r_), mul); }
+
+private:
+	unsigned l_;
+	unsigned r_;
+
+	CicSum(unsigned l, unsigned r) : l_(l), r_(r) {}
+#endif
+
+	static void storeLanes(short *out, int l, int r, long mul) {
+		out[0] = rshift16_round(static_cast<long>(l) * mul);
+		out[1] = rshift16_round(static_cast<long>(r) * mul);
+	}
+};
+
+#endif
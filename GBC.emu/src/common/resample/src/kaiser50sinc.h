@@ -80,6 +80,7 @@ public:
 	virtual void adjustDiv(unsigned div) { polyfir_.adjustDiv(div); }
 	virtual unsigned mul() const { return MUL; }
 	virtual unsigned div() const { return polyfir_.div(); }
+	virtual std::size_t historyLength() const { return polyfir_.phaseLen(); }
 
 private:
 	Array<short> const kernel_;
@@ -112,6 +112,7 @@ public:
 
 	virtual std::size_t maxOut(std::size_t inlen) const { return cores_[0].maxOut(inlen); }
 	virtual std::size_t resample(short *out, short const *in, std::size_t inlen);
+	virtual std::size_t historyLength() const { return 1; }
 
 private:
 	LinintCore<channels> cores_[channels];
@@ -21,6 +21,7 @@
 
 #include "array.h"
 #include "rshift16_round.h"
+#include "stereodotproduct.h"
 #include <algorithm>
 #include <cstring>
 
@@ -31,6 +32,7 @@ public:
 	std::size_t filter(short *out, short const *in, std::size_t inlen);
 	void adjustDiv(unsigned div) { div_ = div; }
 	unsigned div() const { return div_; }
+	std::size_t phaseLen() const { return prevbuf_.size() / channels; }
 
 private:
 	short const *const kernel_;
@@ -94,6 +96,19 @@ std::size_t PolyphaseFir<channels, phases>::filter(short *out,
 	std::size_t x = x_;
 
 	for (; x < (M < inlen ? M : inlen); x += div_) {
+		if (channels == 2) {
+			// adjust phase so we do not start on a virtual 0 sample
+			short const *const k = kernel_ + ((x + 1) % phases) * phaseLen;
+			std::size_t const n = x / phases + 1;
+			std::size_t const prevn = phaseLen - n;
+			StereoSum const prev = stereoDotProduct(k, prevbuf_ + n * 2, prevn);
+			StereoSum const cur = stereoDotProduct(k + prevn, in, n);
+			out[0] = rshift16_round(static_cast<int>(prev.l + cur.l));
+			out[1] = rshift16_round(static_cast<int>(prev.r + cur.r));
+			out += 2;
+			continue;
+		}
+
 		for (int c = 0; c < channels; ++c) {
 			// adjust phase so we do not start on a virtual 0 sample
 			short const *k = kernel_ + ((x + 1) % phases) * phaseLen;
@@ -120,6 +135,17 @@ std::size_t PolyphaseFir<channels, phases>::filter(short *out,
 	// and we would end up referencing more variables which often compiles to bad
 	// code on x86, which is why I'm also hesitant to get rid of the template arguments.
 	for (; x < inlen; x += div_) {
+		if (channels == 2) {
+			// adjust phase so we do not start on a virtual 0 sample
+			short const *const k = kernel_ + ((x + 1) % phases) * phaseLen;
+			short const *const s = in + (x / phases + 1 - phaseLen) * 2;
+			StereoSum const sum = stereoDotProduct(k, s, phaseLen);
+			out[0] = rshift16_round(static_cast<int>(sum.l));
+			out[1] = rshift16_round(static_cast<int>(sum.r));
+			out += 2;
+			continue;
+		}
+
 		for (int c = 0; c < channels-1; c += 2) {
 			// adjust phase so we do not start on a virtual 0 sample
 			short const *k = kernel_ + ((x + 1) % phases) * phaseLen;
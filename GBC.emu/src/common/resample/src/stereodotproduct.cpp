@@ -0,0 +1,131 @@
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License version 2 as     *
+ *   published by the Free Software Foundation.                            *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License version 2 for more details.                *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   version 2 along with this program; if not, write to the               *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA  02110-1301, USA.             *
+ ***************************************************************************/
+#include "stereodotproduct.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define STEREODOTPRODUCT_AVX2
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+StereoSum addTail(StereoSum sum, short const *k, short const *s, std::size_t n) {
+	for (std::size_t i = 0; i < n; ++i) {
+		sum.l += static_cast<unsigned>(k[i] * s[i * 2]);
+		sum.r += static_cast<unsigned>(k[i] * s[i * 2 + 1]);
+	}
+
+	return sum;
+}
+
+#if defined(__SSE2__)
+StereoSum horizontalSum(__m128i acc) {
+	// acc holds left, right, left, right
+	acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+	StereoSum const sum = { static_cast<unsigned>(_mm_cvtsi128_si32(acc)),
+	                        static_cast<unsigned>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 4))) };
+	return sum;
+}
+
+StereoSum dotProductSse2(short const *k, short const *s, std::size_t n) {
+	__m128i acc = _mm_setzero_si128();
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		// reorder L0 R0 L1 R1 L2 R2 L3 R3 to L0 L1 R0 R1 L2 L3 R2 R3 and pair the
+		// taps the same way so madd gives L01 R01 L23 R23
+		__m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const *>(s + i * 2));
+		v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+		__m128i const taps = _mm_loadl_epi64(reinterpret_cast<__m128i const *>(k + i));
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(v, _mm_unpacklo_epi32(taps, taps)));
+	}
+
+	return addTail(horizontalSum(acc), k + i, s + i * 2, n - i);
+}
+
+#ifdef STEREODOTPRODUCT_AVX2
+__attribute__((target("avx2")))
+StereoSum dotProductAvx2(short const *k, short const *s, std::size_t n) {
+	__m256i const frameOrder = _mm256_setr_epi8(
+		0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15,
+		0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15);
+	__m256i const tapOrder = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+	__m256i acc = _mm256_setzero_si256();
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i const v = _mm256_shuffle_epi8(
+			_mm256_loadu_si256(reinterpret_cast<__m256i const *>(s + i * 2)), frameOrder);
+		__m256i const taps = _mm256_permutevar8x32_epi32(
+			_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(k + i))), tapOrder);
+		acc = _mm256_add_epi32(acc, _mm256_madd_epi16(v, taps));
+	}
+
+	__m128i const acc128 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+	return addTail(horizontalSum(acc128), k + i, s + i * 2, n - i);
+}
+#endif
+#elif defined(__ARM_NEON)
+StereoSum dotProductNeon(short const *k, short const *s, std::size_t n) {
+	int32x4_t accl = vdupq_n_s32(0);
+	int32x4_t accr = vdupq_n_s32(0);
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		int16x4x2_t const v = vld2_s16(s + i * 2);
+		int16x4_t const taps = vld1_s16(k + i);
+		accl = vmlal_s16(accl, v.val[0], taps);
+		accr = vmlal_s16(accr, v.val[1], taps);
+	}
+
+	int32x2_t const l = vadd_s32(vget_low_s32(accl), vget_high_s32(accl));
+	int32x2_t const r = vadd_s32(vget_low_s32(accr), vget_high_s32(accr));
+	int32x2_t const lr = vpadd_s32(l, r);
+	StereoSum const sum = { static_cast<unsigned>(vget_lane_s32(lr, 0)),
+	                        static_cast<unsigned>(vget_lane_s32(lr, 1)) };
+	return addTail(sum, k + i, s + i * 2, n - i);
+}
+#else
+StereoSum dotProductScalar(short const *k, short const *s, std::size_t n) {
+	StereoSum const sum = { 0, 0 };
+	return addTail(sum, k, s, n);
+}
+#endif
+
+typedef StereoSum (*DotProductFunc)(short const *k, short const *s, std::size_t n);
+
+DotProductFunc selectDotProduct() {
+#if defined(STEREODOTPRODUCT_AVX2)
+	if (__builtin_cpu_supports("avx2"))
+		return dotProductAvx2;
+#endif
+#if defined(__SSE2__)
+	return dotProductSse2;
+#elif defined(__ARM_NEON)
+	return dotProductNeon;
+#else
+	return dotProductScalar;
+#endif
+}
+
+}
+
+StereoSum stereoDotProduct(short const *k, short const *s, std::size_t n) {
+	static DotProductFunc const dotProduct = selectDotProduct();
+	return dotProduct(k, s, n);
+}
@@ -0,0 +1,31 @@
+/***************************************************************************
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License version 2 as     *
+ *   published by the Free Software Foundation.                            *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License version 2 for more details.                *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   version 2 along with this program; if not, write to the               *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin St, Fifth Floor, Boston, MA  02110-1301, USA.             *
+ ***************************************************************************/
+#ifndef STEREODOTPRODUCT_H
+#define STEREODOTPRODUCT_H
+
+#include <cstddef>
+
+struct StereoSum {
+	unsigned l;
+	unsigned r;
+};
+
+// Sums n kernel taps times the left and right samples of n interleaved stereo frames.
+// The sums wrap around at 32 bits, which gives the same result as a wider sum once
+// it's shifted down and truncated to a 16 bit sample.
+StereoSum stereoDotProduct(short const *k, short const *s, std::size_t n);
+
+#endif
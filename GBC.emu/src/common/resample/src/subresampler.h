@@ -28,6 +28,9 @@ public:
 	virtual unsigned mul() const = 0;
 	virtual unsigned div() const = 0;
 	virtual void adjustDiv(unsigned /*div*/) {}
+
+	/** Returns how many of the most recent input samples still affect the output. */
+	virtual std::size_t historyLength() const { return 0; }
 };
 
 #endif
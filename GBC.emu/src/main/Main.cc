@@ -195,10 +195,79 @@ void GbcSystem::configAudioRate(FrameRate outputFrameRate, int outputRate)
 	{
 		log.info("setting up resampler {} for input rate {}Hz", optionAudioResampler.value(), inputRate);
 		resampler.reset(ResamplerInfo::get(optionAudioResampler).create(inputRate, outputRate, 35112 + 2064));
+		fastForwardResampler.reset();
 		activeResampler = optionAudioResampler;
+		primeResampler(*resampler);
+		lastResampler = resampler.get();
 	}
 }
 
+// Called with the emulation thread suspended, so the resampler being switched to
+// is built and primed here instead of when the emulation thread first uses it
+void GbcSystem::onSpeedMultiplierChanged(double speed)
+{
+	updateFastForwardResampler(speed);
+	auto r = speed > 1. && fastForwardResampler ? fastForwardResampler.get() : resampler.get();
+	if(r && r != lastResampler)
+	{
+		primeResampler(*r);
+		lastResampler = r;
+	}
+}
+
+void GbcSystem::updateFastForwardResampler(double speed)
+{
+	if(!resampler || speed <= 1.)
+		return;
+	// resample directly to the rate EmuAudio would otherwise convert to in a second pass
+	long outputRate = std::round(resampler->outRate() / speed);
+	if(fastForwardResampler && fastForwardResampler->outRate() == outputRate)
+		return;
+	log.info("setting up fast-forward resampler for output rate {}Hz", outputRate);
+	if(lastResampler == fastForwardResampler.get())
+		lastResampler = {};
+	fastForwardResampler.reset(ResamplerInfo::get(activeResampler).create(resampler->inRate(), outputRate, 35112 + 2064));
+}
+
+// Runs the recent input covering the filter length through a resampler being switched to, discarding the output,
+// so its filter history continues from the current audio instead of silence or stale samples
+void GbcSystem::primeResampler(Resampler &r)
+{
+	constexpr size_t maxFrames = 2064;
+	DynArray<uint32_t> scratch{r.maxOut(maxFrames)};
+	auto feed = [&](std::span<const uint_least32_t> frames)
+	{
+		for(size_t i = 0; i < frames.size(); i += maxFrames)
+		{
+			auto size = std::min(frames.size() - i, maxFrames);
+			r.resample((short*)scratch.data(), (const short*)&frames[i], size);
+		}
+	};
+	auto primeFrames = std::min(r.historyLength(), resamplerHistory.size());
+	log.debug("priming resampler with {} frames", primeFrames);
+	std::span history{resamplerHistory};
+	auto start = (resamplerHistoryPos + history.size() - primeFrames) % history.size();
+	if(start + primeFrames <= history.size())
+	{
+		feed(history.subspan(start, primeFrames));
+	}
+	else
+	{
+		feed(history.subspan(start));
+		feed(history.first(resamplerHistoryPos));
+	}
+}
+
+void GbcSystem::updateResamplerHistory(std::span<const uint_least32_t> frames)
+{
+	if(frames.size() > resamplerHistory.size())
+		frames = frames.last(resamplerHistory.size());
+	auto size = std::min(frames.size(), resamplerHistory.size() - resamplerHistoryPos);
+	std::ranges::copy(frames.first(size), resamplerHistory.begin() + resamplerHistoryPos);
+	std::ranges::copy(frames.subspan(size), resamplerHistory.begin());
+	resamplerHistoryPos = (resamplerHistoryPos + frames.size()) % resamplerHistory.size();
+}
+
 size_t GbcSystem::runUntilVideoFrame(uint_least32_t *videoBuf, std::ptrdiff_t pitch,
 	EmuAudio *audio, VideoFrameDelegate videoFrameCallback)
 {
@@ -215,9 +284,12 @@ size_t GbcSystem::runUntilVideoFrame(uint_least32_t *videoBuf, std::ptrdiff_t pi
 		{
 			constexpr size_t buffSize = (snd.size() / (2097152./48000.) + 1); // TODO: std::ceil() is constexpr with GCC but not Clang yet
 			std::array<uint32_t, buffSize> destBuff;
-			unsigned destFrames = resampler->resample((short*)destBuff.data(), (const short*)snd.data(), samples);
+			bool speedAdjusted = audio->speed() > 1. && fastForwardResampler;
+			auto &r = speedAdjusted ? *fastForwardResampler : *resampler;
+			unsigned destFrames = r.resample((short*)destBuff.data(), (const short*)snd.data(), samples);
 			assume(destFrames <= destBuff.size());
-			audio->writeFrames(destBuff.data(), destFrames);
+			audio->writeFrames(destBuff.data(), destFrames, {.speedAdjusted = speedAdjusted});
+			updateResamplerHistory({snd.data(), samples});
 		}
 	} while(!didOutputFrame);
 	return samplesEmulated;
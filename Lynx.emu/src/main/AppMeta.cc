@@ -26,6 +26,7 @@ namespace EmuEx
 const std::string_view AppMeta::creditsViewStr{CREDITS_INFO_STRING "(c) 2011-2026\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io"};
 const std::string_view AppMeta::configFilename{"LynxEmu.config"};
 const bool AppMeta::needsGlobalInstance{true};
+const bool AppMeta::compressesSaveStates{true};
 const AspectRatioInfo AppMeta::aspectRatioInfo{"80:51 (Original)", {80, 51}};
 const NameFilterFunc AppMeta::defaultFsFilter = [](std::string_view name) { return endsWithAnyCaseless(name, ".lnx", ".lyx", ".o"); };
 
@@ -52,6 +52,7 @@ FS::FileString LynxSystem::stateFilename(int slot, std::string_view name) const
 size_t LynxSystem::stateSize() { return stateSizeMDFN(); }
 void LynxSystem::readState(EmuApp&, std::span<uint8_t> buff) { readStateMDFN(buff); }
 size_t LynxSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
+int LynxSystem::stateCompressionLevel() const { return stateCompressionLevelMDFN(); }
 
 void LynxSystem::closeSystem()
 {
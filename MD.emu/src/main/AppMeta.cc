@@ -50,6 +50,12 @@ static bool hasMDWithCDExtension(std::string_view name)
 
 const NameFilterFunc AppMeta::defaultFsFilter{hasMDWithCDExtension};
 
+bool AppMeta::canExtractArchiveEntry(std::string_view name, size_t size)
+{
+	// CD images are loaded through the archive VFS, large .bin files are treated as CDs
+	return !hasMDCDExtension(name) && !(hasBinExtension(name) && size > 1024*1024*10);
+}
+
 constexpr auto dpadKeyInfo = makeArray<KeyInfo>
 (
 	MdKey::Up,
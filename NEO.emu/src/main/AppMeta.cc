@@ -30,6 +30,7 @@ const bool AppMeta::canRenderRGBA8888{};
 const bool AppMeta::hasRectangularPixels{true};
 const int AppMeta::maxPlayers{2};
 const bool AppMeta::needsGlobalInstance{true};
+const bool AppMeta::compressesSaveStates{true};
 const NameFilterFunc AppMeta::defaultFsFilter = [](std::string_view name) { return false; }; // archives handled by EmuFramework
 
 constexpr auto dpadKeyInfo = makeArray<KeyInfo>
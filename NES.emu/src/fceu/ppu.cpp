@@ -1875,14 +1875,18 @@ int FCEUPPU_Loop(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::NesSystemHolder& sy
 			else
 				totalscanlines = normalscanlines + (overclock_enabled ? postrenderscanlines : 0);
 
+			FCEUPPU_FrameStart(taskCtx, sys, video);
 			for (scanline = 0; scanline < totalscanlines; ) {	//scanline is incremented in  DoLine.  Evil. :/
 				deempcnt[deemp]++;
 
+				int line = scanline;
 				if (scanline < 240) {
 					DEBUG(FCEUD_UpdatePPUView(scanline, 1));
 				}
 
 				DoLine();
+				if (line < 240)
+					FCEUPPU_LineReady(sys, line, XBuf + (line << 8));
 
 				if (scanline < normalscanlines || scanline == totalscanlines)
 					overclocking = 0;
@@ -13,6 +13,9 @@ void FCEUPPU_Reset(void);
 void FCEUPPU_Power(void);
 int FCEUPPU_Loop(EmuEx::EmuSystemTaskContext, EmuEx::NesSystemHolder&, EmuEx::EmuVideo*, EmuEx::EmuAudio*, int skip);
 void FCEUPPU_FrameReady(EmuEx::EmuSystemTaskContext, EmuEx::NesSystemHolder&, EmuEx::EmuVideo*, uint8* data);
+// lets the frontend convert each finished scanline straight into the video image
+void FCEUPPU_FrameStart(EmuEx::EmuSystemTaskContext, EmuEx::NesSystemHolder&, EmuEx::EmuVideo*);
+void FCEUPPU_LineReady(EmuEx::NesSystemHolder&, int line, const uint8* data);
 
 void FCEUPPU_LineUpdate();
 void FCEUPPU_SetVideoSystem(int w);
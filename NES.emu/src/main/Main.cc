@@ -368,27 +368,56 @@ void NesSystem::updateVideoPixmap(EmuVideo &video, bool horizontalCrop, int line
 	video.setFormat({{xPixels, lines}, pixFmt});
 }
 
-void NesSystem::renderVideo(EmuSystemTaskContext taskCtx, EmuVideo &video, uint8 *buf)
+void NesSystem::writeVideo(MutablePixmapView pix, PixmapView ppuPix)
 {
-	auto img = video.startFrame(taskCtx);
-	auto pix = img.pixmap();
-	PixmapView ppuPix{{{256, 256}, PixelFmtI8}, buf};
-	int xStart = pix.w() == 256 ? 0 : 8;
-	int yStart = optionStartVideoLine;
-	auto ppuPixRegion = ppuPix.subView({xStart, yStart}, pix.size());
-	assume(pix.size() == ppuPixRegion.size());
+	assume(pix.size() == ppuPix.size());
 	if(pix.format() == PixelFmtRGB565)
 	{
-		pix.writeTransformed([&](uint8 p){ return nativeCol.col16[p]; }, ppuPixRegion);
+		pix.writeLookup<uint16_t>(nativeCol.col16, ppuPix);
 	}
 	else
 	{
 		assume(pix.format().bytesPerPixel() == 4);
-		pix.writeTransformed([&](uint8 p){ return nativeCol.col32[p]; }, ppuPixRegion);
+		pix.writeLookup<uint32_t>(nativeCol.col32, ppuPix);
 	}
+}
+
+void NesSystem::renderVideo(EmuSystemTaskContext taskCtx, EmuVideo &video, uint8 *buf)
+{
+	if(videoImg)
+	{
+		// scanlines were already written by renderVideoLine()
+		std::exchange(videoImg, {}).endFrame();
+		return;
+	}
+	auto img = video.startFrame(taskCtx);
+	auto pix = img.pixmap();
+	PixmapView ppuPix{{{256, 256}, PixelFmtI8}, buf};
+	int xStart = pix.w() == 256 ? 0 : 8;
+	int yStart = optionStartVideoLine;
+	writeVideo(pix, ppuPix.subView({xStart, yStart}, pix.size()));
+	video.addCopiedBytes(pix.unpaddedBytes());
 	img.endFrame();
 }
 
+void NesSystem::startVideoFrame(EmuSystemTaskContext taskCtx, EmuVideo &video)
+{
+	videoImg = video.startFrame(taskCtx);
+}
+
+void NesSystem::renderVideoLine(int line, const uint8 *buf)
+{
+	if(!videoImg)
+		return;
+	auto pix = videoImg.pixmap();
+	int y = line - optionStartVideoLine;
+	if(y < 0 || y >= pix.h())
+		return;
+	PixmapView ppuLinePix{{{256, 1}, PixelFmtI8}, buf};
+	int xStart = pix.w() == 256 ? 0 : 8;
+	writeVideo(pix.subView({0, y}, {pix.w(), 1}), ppuLinePix.subView({xStart, 0}, {pix.w(), 1}));
+}
+
 void NesSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio *audio)
 {
 	bool skip = !video && !optionCompatibleFrameskip;
@@ -437,6 +466,17 @@ extern "C++" void FCEUPPU_FrameReady(EmuEx::EmuSystemTaskContext taskCtx, EmuEx:
 	sys.renderVideo(taskCtx, *video, buf);
 }
 
+extern "C++" void FCEUPPU_FrameStart(EmuEx::EmuSystemTaskContext taskCtx, EmuEx::NesSystemHolder& sys, EmuEx::EmuVideo* video)
+{
+	if(video)
+		sys.startVideoFrame(taskCtx, *video);
+}
+
+extern "C++" void FCEUPPU_LineReady(EmuEx::NesSystemHolder& sys, int line, const uint8* data)
+{
+	sys.renderVideoLine(line, data);
+}
+
 extern "C++" void setDiskIsAccessing(bool on)
 {
 	using namespace EmuEx;
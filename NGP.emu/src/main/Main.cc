@@ -49,6 +49,7 @@ FS::FileString NgpSystem::stateFilename(int slot, std::string_view name) const
 size_t NgpSystem::stateSize() { return stateSizeMDFN(); }
 void NgpSystem::readState(EmuApp&, std::span<uint8_t> buff) { readStateMDFN(buff); }
 size_t NgpSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
+int NgpSystem::stateCompressionLevel() const { return stateCompressionLevelMDFN(); }
 
 static FS::PathString saveFilename(const EmuApp &app)
 {
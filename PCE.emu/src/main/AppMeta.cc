@@ -30,8 +30,11 @@ const bool AppMeta::hasRectangularPixels{true};
 const bool AppMeta::stateSizeChangesAtRuntime{true};
 const int AppMeta::maxPlayers{5};
 const bool AppMeta::needsGlobalInstance{true};
+const bool AppMeta::compressesSaveStates{true};
 const NameFilterFunc AppMeta::defaultFsFilter{hasPCEWithCDExtension};
 
+bool AppMeta::canExtractArchiveEntry(std::string_view name, size_t) { return !hasCDExtension(name); }
+
 constexpr auto dpadKeyInfo = makeArray<KeyInfo>
 (
 	PceKey::Up,
@@ -71,6 +71,11 @@ void PceSystem::closeSystem()
 	clearCDInterfaces(CDInterfaces);
 }
 
+void PceSystem::addIOThreadIds(std::vector<ThreadId> &ids) const
+{
+	addCDReadThreadIds(CDInterfaces, ids);
+}
+
 WSize PceSystem::multiresVideoBaseSize() const { return {512, 0}; }
 
 void PceSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDelegate)
@@ -176,6 +181,7 @@ void PceSystem::reset(EmuApp &, ResetMode mode)
 size_t PceSystem::stateSize() { return stateSizeMDFN(); }
 void PceSystem::readState(EmuApp&, std::span<uint8_t> buff) { readStateMDFN(buff); }
 size_t PceSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
+int PceSystem::stateCompressionLevel() const { return stateCompressionLevelMDFN(); }
 
 double PceSystem::videoAspectRatioScale() const
 {
@@ -286,6 +292,7 @@ static void renderMultiresOutput(EmulateSpecStruct spec, PixmapView srcPix, int
 			destPixAddr += img.pixmap().paddingPixels();
 		}
 	}
+	spec.video->addCopiedBytes(img.pixmap().unpaddedBytes());
 	img.endFrame();
 }
 
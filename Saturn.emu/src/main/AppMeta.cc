@@ -34,6 +34,7 @@ const bool AppMeta::canRenderRGB565{};
 const bool AppMeta::stateSizeChangesAtRuntime{true};
 const int AppMeta::maxPlayers{12};
 const bool AppMeta::needsGlobalInstance{true};
+const bool AppMeta::compressesSaveStates{true};
 const NameFilterFunc AppMeta::defaultFsFilter{hasCDExtension};
 
 constexpr auto dpadKeyInfo = makeArray<KeyInfo>
@@ -34,6 +34,7 @@ extern bool ResetPending;
 
 void SaveBackupRAM(IG::FileIO&);
 void LoadBackupRAM(IG::FileIO&);
+std::array<std::span<uint8>, 3> GuestMemory();
 }
 
 namespace EmuEx
@@ -164,6 +165,11 @@ void SaturnSystem::closeSystem()
 	rtcFileIO = {};
 }
 
+void SaturnSystem::addIOThreadIds(std::vector<ThreadId> &ids) const
+{
+	addCDReadThreadIds(CDInterfaces, ids);
+}
+
 WSize SaturnSystem::multiresVideoBaseSize() const { return {704, 0}; }
 
 static FrameRate makeFrameRate(uint8 InterlaceMode)
@@ -275,6 +281,8 @@ void SaturnSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDele
 	mdfnGameInfo.LoadCD(&CDInterfaces);
 	MDFN_IEN_SS::CDB_SetDisc(false, CDInterfaces[0]);
 	unloadCD.cancel();
+	for(auto mem : MDFN_IEN_SS::GuestMemory())
+		applyGuestMemoryFlags(mem);
 	mdfnGameInfo.SetInput(12, "builtin", reinterpret_cast<uint8*>(&inputBuff[12]));
 	applyInputConfig(EmuApp::get(appContext()));
 	if(!videoLines)
@@ -392,6 +400,7 @@ double SaturnSystem::videoAspectRatioScale() const
 size_t SaturnSystem::stateSize() { return currStateSize; }
 void SaturnSystem::readState(EmuApp&, std::span<uint8_t> buff) { readStateMDFN(buff); }
 size_t SaturnSystem::writeState(std::span<uint8_t> buff, SaveStateFlags flags) { return writeStateMDFN(buff, flags); }
+int SaturnSystem::stateCompressionLevel() const { return stateCompressionLevelMDFN(); }
 
 }
 
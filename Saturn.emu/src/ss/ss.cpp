@@ -1848,6 +1848,17 @@ void LoadBackupRAM(IG::FileIO& brs)
  }
 }
 
+namespace VDP1
+{
+MDFN_HIDE extern uint16 FB[2][0x20000];
+}
+
+// Largest emulated memories, randomly accessed every frame
+std::array<std::span<uint8>, 3> GuestMemory()
+{
+ return {IG::asWritableBytes(WorkRAML), IG::asWritableBytes(WorkRAMH), IG::asWritableBytes(VDP1::FB)};
+}
+
 static MDFN_COLD void BackupBackupRAM(void)
 {
  MDFN_BackupSavFile(10, "bkr");
@@ -27,6 +27,7 @@ const bool AppMeta::canRenderRGBA8888{};
 const bool AppMeta::hasRectangularPixels{true};
 const int AppMeta::maxPlayers{5};
 const bool AppMeta::needsGlobalInstance{true};
+const bool AppMeta::compressesSaveStates{true};
 const NameFilterFunc AppMeta::defaultFsFilter = [](std::string_view name)
 {
 	return endsWithAnyCaseless(name, ".smc", ".sfc", ".swc", ".bs", ".st", ".fig", ".mgd");
@@ -267,6 +267,9 @@ void Snes9xSystem::loadContent(IO &io, EmuSystemCreateParams, OnLoadProgressDele
 			throw std::runtime_error("Error loading ROM");
 		}
 	}
+	applyGuestMemoryFlags(Memory.RAM);
+	applyGuestMemoryFlags(Memory.VRAM);
+	applyGuestMemoryFlags(std::span{Memory.ROMStorage});
 	setupSNESInput(EmuApp::get(appContext()).defaultVController());
 	saveStateSize = S9xFreezeSize();
 	IPPU.RenderThisFrame = TRUE;
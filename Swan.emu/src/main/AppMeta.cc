@@ -27,6 +27,7 @@ namespace EmuEx
 const std::string_view AppMeta::creditsViewStr{CREDITS_INFO_STRING "(c) 2011-2026\nRobert Broglia\nwww.explusalpha.com\n\nPortions (c) the\nMednafen Team\nmednafen.github.io"};
 const std::string_view AppMeta::configFilename{"SwanEmu.config"};
 const bool AppMeta::needsGlobalInstance{true};
+const bool AppMeta::compressesSaveStates{true};
 const NameFilterFunc AppMeta::defaultFsFilter = [](std::string_view name) { return endsWithAnyCaseless(name, ".ws", ".wsc", ".bin"); };
 const AspectRatioInfo AppMeta::aspectRatioInfo{"14:9 (Original)", {14, 9}};
 
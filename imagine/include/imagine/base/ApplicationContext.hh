@@ -123,6 +123,7 @@ public:
 	int cpuCount() const;
 	int maxCPUFrequencyKHz(int cpuIdx) const;
 	CPUMask performanceCPUMask() const;
+	CPUMask cpuMask(CPUCoreType) const;
 	PerformanceHintManager performanceHintManager();
 	GameManager gameManager();
 
@@ -51,6 +51,12 @@ public:
 	operator const Texture&() const;
 	bool isExternal() const;
 	int buffers() const;
+	// for TextureBufferImageMode::Triple, call from the renderer thread to upload the most recently unlocked buffer,
+	// returns false if no new buffer was published since the last call, which is counted as a
+	// duplicated frame in takeFrameStats() if countDuplicate is set
+	bool updateFromNewestBuffer(bool countDuplicate = true);
+	TextureBufferFrameStats takeFrameStats();
+	bool usesMailbox() const;
 };
 
 }
@@ -19,6 +19,7 @@
 #ifndef IG_USE_MODULE_STD
 #include <span>
 #include <string_view>
+#include <vector>
 #endif
 
 #ifdef CONFIG_GFX_OPENGL
@@ -40,8 +41,10 @@ public:
 	};
 
 	using ShaderImpl::ShaderImpl;
-	Shader(RendererTask &, std::span<std::string_view> srcs, ShaderType type, CompileMode mode = CompileMode::NORMAL);
-	Shader(RendererTask &, std::string_view src, ShaderType type, CompileMode mode = CompileMode::NORMAL);
+	Shader(RendererTask &, std::span<std::string_view> srcs, ShaderType type, CompileMode mode = CompileMode::NORMAL,
+		bool backgroundCompile = false);
+	Shader(RendererTask &, std::string_view src, ShaderType type, CompileMode mode = CompileMode::NORMAL,
+		bool backgroundCompile = false);
 	explicit operator bool() const;
 };
 
@@ -55,7 +58,18 @@ struct ProgramFlags
 {
 	uint8_t
 	hasColor:1{},
-	hasTexture:1{};
+	hasTexture:1{},
+	retrievableBinary:1{}, // hint that binary() will be called after linking
+	backgroundCompile:1{}; // link on a context shared with the renderer, for on-demand programs
+};
+
+// Driver specific linked program data, only valid with the same driver it came from
+struct ProgramBinary
+{
+	std::vector<uint8_t> data;
+	uint32_t format{};
+
+	explicit operator bool() const { return data.size(); }
 };
 
 class Program : public ProgramImpl
@@ -64,6 +78,8 @@ public:
 	using ProgramImpl::ProgramImpl;
 	Program(RendererTask &, NativeShader vShader, NativeShader fShader,
 		ProgramFlags, std::span<UniformLocationDesc>);
+	Program(RendererTask &, const ProgramBinary &, ProgramFlags, std::span<UniformLocationDesc>);
+	ProgramBinary binary();
 	int uniformLocation(const char *name);
 	void uniform(int location, float v1);
 	void uniform(int location, float v1, float v2);
@@ -103,13 +103,15 @@ public:
 
 	// shaders
 
-	Shader makeShader(std::span<std::string_view> srcs, ShaderType type);
-	Shader makeShader(std::string_view src, ShaderType type);
-	Shader makeCompatShader(std::span<std::string_view> srcs, ShaderType type);
-	Shader makeCompatShader(std::string_view src, ShaderType type);
+	Shader makeShader(std::span<std::string_view> srcs, ShaderType type, bool backgroundCompile = false);
+	Shader makeShader(std::string_view src, ShaderType type, bool backgroundCompile = false);
+	Shader makeCompatShader(std::span<std::string_view> srcs, ShaderType type, bool backgroundCompile = false);
+	Shader makeCompatShader(std::string_view src, ShaderType type, bool backgroundCompile = false);
 	BasicEffect &basicEffect();
 	void releaseShaderCompiler();
 	void autoReleaseShaderCompiler();
+	bool supportsProgramBinaries() const;
+	std::string_view driverName() const; // identifies the driver that program binaries are valid for
 
 	// resources
 
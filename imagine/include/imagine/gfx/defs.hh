@@ -117,7 +117,15 @@ enum class TextureBufferMode : uint8_t
 
 enum class TextureBufferImageMode : uint8_t
 {
-	Single, Double
+	Single, Double,
+	// lock-free mailbox, unlock() publishes the newest buffer and the renderer uploads it when drawing
+	Triple
+};
+
+struct TextureBufferFrameStats
+{
+	int dropped{}; // published buffers replaced before the renderer uploaded them
+	int duplicated{}; // renderer updates with no newly published buffer
 };
 
 enum class DrawAsyncMode : uint8_t
@@ -24,6 +24,7 @@
 #include <memory>
 #include <variant>
 #include <array>
+#include <atomic>
 #endif
 
 namespace IG::Gfx
@@ -35,6 +36,57 @@ class PixmapBufferTexture;
 namespace IG::Gfx
 {
 
+// Triple buffer index exchange, the writer publishes its back buffer as the newest one and
+// gets back the previously published buffer, the renderer swaps the newest buffer with its front buffer
+
+class TextureBufferMailbox
+{
+public:
+	TextureBufferMailbox() = default;
+
+	void reset()
+	{
+		ready.store(1, std::memory_order::relaxed);
+		front = 2;
+	}
+
+	int publish(int backIdx)
+	{
+		auto prevReady = ready.exchange(backIdx | freshBit, std::memory_order::acq_rel);
+		if(prevReady & freshBit)
+			dropped++;
+		return prevReady & ~freshBit;
+	}
+
+	int acquire(bool countDuplicate)
+	{
+		if(!(ready.load(std::memory_order::relaxed) & freshBit))
+		{
+			if(countDuplicate)
+				duplicated.fetch_add(1, std::memory_order::relaxed);
+			return -1;
+		}
+		front = ready.exchange(front, std::memory_order::acq_rel) & ~freshBit;
+		return front;
+	}
+
+	// true when acquire() will hand the current front buffer back to the writer
+	bool hasNewBuffer() const { return ready.load(std::memory_order::relaxed) & freshBit; }
+	int frontIndex() const { return front; }
+
+	TextureBufferFrameStats takeStats()
+	{
+		return {std::exchange(dropped, 0), duplicated.exchange(0, std::memory_order::relaxed)};
+	}
+
+private:
+	static constexpr uint8_t freshBit = 0x4;
+	std::atomic_uint8_t ready{1};
+	std::atomic_int duplicated{}; // updated by the renderer thread
+	int dropped{}; // updated by the writer thread
+	int8_t front{2}; // only accessed by the renderer thread
+};
+
 template<class Impl, class BufferInfo>
 class GLTextureStorage: public Texture
 {
@@ -43,28 +95,32 @@ public:
 
 	GLTextureStorage(RendererTask& rTask, TextureConfig config, TextureBufferImageMode imageMode):
 		Texture{rTask, config},
-		bufferIdx{imageMode == TextureBufferImageMode::Single ? SINGLE_BUFFER_VALUE : (int8_t)0} {}
+		mailbox{imageMode == TextureBufferImageMode::Triple ? std::make_unique<TextureBufferMailbox>() : nullptr},
+		imageMode_{imageMode} {}
 
 	bool setFormat(PixmapDesc, ColorSpace, TextureSamplerConfig);
 	void writeAligned(PixmapView pixmap, int assumeAlign, TextureWriteFlags writeFlags = {});
 	LockedTextureBuffer lock(TextureBufferFlags bufferFlags = {});
 	void unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags = {});
-	auto imageMode() const { return bufferIdx == SINGLE_BUFFER_VALUE ? TextureBufferImageMode::Single : TextureBufferImageMode::Double; }
-	int buffers() const { return imageMode() == TextureBufferImageMode::Single ? 1 : 2; }
+	bool updateFromNewestBuffer(bool countDuplicate);
+	TextureBufferFrameStats takeFrameStats() { return mailbox ? mailbox->takeStats() : TextureBufferFrameStats{}; }
+	auto imageMode() const { return imageMode_; }
+	int buffers() const { return int(imageMode_) + 1; }
 
 protected:
+	std::array<BufferInfo, 3> info{};
+	std::unique_ptr<TextureBufferMailbox> mailbox;
 	int8_t bufferIdx{};
-	std::array<BufferInfo, 2> info{};
-	static constexpr int8_t SINGLE_BUFFER_VALUE = 2;
+	TextureBufferImageMode imageMode_{};
 
 	BufferInfo currentBuffer() const
 	{
-		return buffers() == 1 ? info[0] : info[bufferIdx];
+		return info[bufferIdx];
 	}
 
 	void swapBuffer()
 	{
-		if(buffers() == 1)
+		if(imageMode_ != TextureBufferImageMode::Double)
 			return;
 		bufferIdx = (bufferIdx + 1) % 2;
 	}
@@ -96,6 +152,14 @@ struct GLPixelBufferInfo
 	void *dataStoreOffset() const { return pboDataOffset; }
 };
 
+struct GLSyncDeleter
+{
+	RendererTask *rTask{};
+
+	void operator()(GLsync) const;
+};
+using UniqueGLSync = UniqueResource<GLsync, GLSyncDeleter>;
+
 class GLPixelBufferStorage final: public GLTextureStorage<GLPixelBufferStorage, GLPixelBufferInfo>
 {
 public:
@@ -103,9 +167,15 @@ public:
 	GLPixelBufferStorage(RendererTask&, TextureConfig, TextureBufferImageMode);
 	void initBuffer(PixmapDesc, TextureBufferImageMode);
 	GLuint pbo() const { return pixelBuff.get(); }
+	void waitForUpload(int idx);
+	void fenceUpload(int idx);
+	void clearUploadFences();
 
 private:
 	UniqueGLBuffer pixelBuff{};
+	// persistent mapped buffers are written by the CPU while mapped, so one must not be
+	// handed back to the writer until the GL has finished the texture upload reading from it
+	std::array<UniqueGLSync, 3> uploadFences{};
 };
 
 using GLPixmapBufferTextureVariant = std::variant<
@@ -31,6 +31,7 @@
 #ifndef IG_USE_MODULE_STD
 #include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 #endif
 
@@ -110,6 +111,10 @@ public:
 		//static void glWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) { ::glWaitSync(sync, flags, timeout); }
 		#endif
 	#endif
+	// OpenGL ES 3.0, OpenGL 4.1, GL_ARB_get_program_binary or GL_OES_get_program_binary
+	void (* GL_APIENTRY glGetProgramBinary) (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary){};
+	void (* GL_APIENTRY glProgramBinary) (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length){};
+	void (* GL_APIENTRY glProgramParameteri) (GLuint program, GLenum pname, GLint value){};
 	#ifdef __ANDROID__
 	void (GL_APIENTRYP glEGLImageTargetTexStorageEXT)(GLenum target, GLeglImageOES image, const GLint* attrib_list){};
 	#endif
@@ -144,6 +149,7 @@ public:
 	bool hasImmutableBufferStorage() const;
 	bool hasMemoryBarriers() const;
 	bool hasVAOFuncs() const;
+	bool hasProgramBinaries() const;
 	GLsync fenceSync(GLDisplay dpy);
 	void deleteSync(GLDisplay dpy, GLsync sync);
 	GLenum clientWaitSync(GLDisplay dpy, GLsync sync, GLbitfield flags, GLuint64 timeout);
@@ -157,9 +163,11 @@ public:
 	DrawContextSupport support{};
 	[[no_unique_address]] GLManager glManager;
 	RendererTask mainTask;
+	GLTask compileTask; // shares objects with mainTask, compiles shaders without blocking drawing
 	BasicEffect basicEffect_{};
 	Gfx::QuadIndexArray<uint8_t> quadIndices;
 	CustomEvent releaseShaderCompilerEvent;
+	std::string glDriverName;
 	static bool checkGLErrors;
 	static bool checkGLErrorsVerbose;
 
@@ -167,6 +175,7 @@ public:
 	GLDisplay glDisplay() const;
 	bool makeWindowDrawable(RendererTask &task, Window &, GLBufferConfig, GLColorSpace);
 	int toSwapInterval(const Window &win, PresentMode mode) const;
+	GLTask &shaderCompileTask();
 
 protected:
 	void addEventHandlers(ApplicationContext, RendererTask &);
@@ -181,6 +190,7 @@ protected:
 	void setupImmutableBufferStorage();
 	void setupMemoryBarrier();
 	void setupVAOFuncs(bool oes = false);
+	void setupProgramBinaries(bool oes = false);
 	void setupFenceSync();
 	void setupAppleFenceSync();
 	void setupEglFenceSync(std::string_view eglExtenstionStr);
@@ -188,6 +198,9 @@ protected:
 	bool attachWindow(Window &, GLBufferConfig, GLColorSpace);
 	NativeWindowFormat nativeWindowFormat(GLBufferConfig) const;
 	bool initBasicEffect();
+
+private:
+	bool compileTaskFailed{};
 };
 
 using RendererImpl = GLRenderer;
@@ -43,6 +43,7 @@ struct GLTaskConfig
 	GLManager *glManagerPtr{};
 	GLBufferConfig bufferConfig{};
 	Drawable initialDrawable{};
+	NativeGLContext shareContext{};
 };
 
 // Wraps an OpenGL context in a thread + message port
@@ -137,7 +138,7 @@ protected:
 	CommandMessagePort commandPort;
 	ThreadId threadId_{};
 
-	GLContext makeGLContext(GLManager &, GLBufferConfig bufferConf);
+	GLContext makeGLContext(GLManager &, GLBufferConfig bufferConf, NativeGLContext shareContext);
 	void deinit();
 };
 
@@ -98,6 +98,8 @@ protected:
 	void updateFormatInfo(PixmapDesc, int8_t levels, GLenum target = GL_TEXTURE_2D);
 	static void setSwizzleForFormatInGL(const Renderer &r, PixelFormatId format, GLuint tex);
 	static void setSamplerParamsInGL(SamplerParams params, GLenum target = GL_TEXTURE_2D);
+	static void writeBufferInGL(const Renderer &, GLuint texName, PixmapView, const void *bufferOffset,
+		WPt destPos, GLuint pbo, int level);
 	void updateLevelsForMipmapGeneration();
 	#ifdef __ANDROID__
 	void initWithEGLImage(EGLImageKHR, PixmapDesc, SamplerParams, bool isMutable);
@@ -51,6 +51,7 @@ public:
 	auto data(this auto&& self) { return self.buff.data(); }
 	std::span<uint8_t> map() { return {data(), size()}; }
 	explicit operator bool() const { return data(); }
+	bool isMappedFile() const { return buff.isMappedFile(); }
 	IOBuffer releaseBuffer() { return std::move(buff); }
 	std::span<uint8_t> subSpan(off_t offset, size_t maxBytes) const;
 	MapIO subView(off_t offset, size_t maxBytes) const { return IOBuffer{subSpan(offset, maxBytes), 0}; }
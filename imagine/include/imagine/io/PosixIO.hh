@@ -26,7 +26,9 @@ struct IOMapFlags
 {
 	uint8_t
 	write:1{},
-	populatePages:1{};
+	populatePages:1{},
+	// writable copy-on-write mapping, changes are never written back to the file
+	privateCopy:1{};
 };
 
 class PosixIO : public IOUtils<PosixIO>
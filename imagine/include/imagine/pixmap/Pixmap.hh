@@ -24,7 +24,9 @@
 #include <imagine/util/mdspan.hh>
 #include <imagine/util/concepts.hh>
 #ifndef IG_USE_MODULE_STD
+#include <bit>
 #include <cstring>
+#include <span>
 #include <utility>
 #endif
 
@@ -45,6 +47,34 @@ uint32_t transformRGB565ToBGRX8888(uint16_t p);
 uint32_t transformRGB888ToRGBX8888(RGBTripleArray p);
 uint32_t transformRGB888ToBGRX8888(RGBTripleArray p);
 
+// Whole line conversions, vectorized where the target supports it
+void transformLineRGBA8888ToBGRA8888(const uint32_t *src, size_t count, uint32_t *dest);
+void transformLineRGBX8888ToRGB565(const uint32_t *src, size_t count, uint16_t *dest);
+void transformLineBGRX8888ToRGB565(const uint32_t *src, size_t count, uint16_t *dest);
+void transformLineRGB565ToRGBX8888(const uint16_t *src, size_t count, uint32_t *dest);
+void transformLineRGB565ToBGRX8888(const uint16_t *src, size_t count, uint32_t *dest);
+
+template <class Dest>
+constexpr void transformLineLookup(const uint8_t *src, size_t count, Dest *dest, const Dest *palette)
+{
+	size_t i = 0;
+	for(; i + 4 <= count; i += 4)
+	{
+		uint32_t idx;
+		std::memcpy(&idx, src + i, sizeof(idx));
+		if constexpr(std::endian::native == std::endian::big)
+			idx = std::byteswap(idx);
+		dest[i]     = palette[idx & 0xFF];
+		dest[i + 1] = palette[idx >> 8 & 0xFF];
+		dest[i + 2] = palette[idx >> 16 & 0xFF];
+		dest[i + 3] = palette[idx >> 24];
+	}
+	for(; i < count; i++)
+	{
+		dest[i] = palette[src[i]];
+	}
+}
+
 template <class Func>
 concept PixmapTransformFunc =
 		requires (Func &&f, unsigned data){ f(data); } ||
@@ -323,6 +353,39 @@ public:
 		writeTransformed2<Src, Dest>(func, pixmap);
 	}
 
+	// Write 8-bit palette indices from pixmap as colors looked up in palette
+	template <class Dest>
+	void writeLookup(std::span<const Dest, 256> palette, auto pixmap) requires(dataIsMutable)
+	{
+		assume(format().bytesPerPixel() == sizeof(Dest));
+		assume(pixmap.format().bytesPerPixel() == 1);
+		writeLines<uint8_t, Dest>([p = palette.data()](const uint8_t *src, size_t count, Dest *dest)
+			{
+				transformLineLookup(src, count, dest, p);
+			}, pixmap);
+	}
+
+	// Apply lineFunc(src, count, dest) over each line, or once if both pixmaps are contiguous
+	template <class Src, class Dest>
+	void writeLines(auto &&lineFunc, auto pixmap) requires(dataIsMutable)
+	{
+		auto srcData = (const Src*)pixmap.data();
+		auto destData = (Dest*)data_;
+		if(w() == pixmap.w() && !isPadded() && !pixmap.isPadded())
+		{
+			lineFunc(srcData, size_t(pixmap.w() * pixmap.h()), destData);
+		}
+		else
+		{
+			for([[maybe_unused]] auto h : iotaCount(pixmap.h()))
+			{
+				lineFunc(srcData, size_t(pixmap.w()), destData);
+				srcData += pixmap.pitchPx();
+				destData += pitchPx();
+			}
+		}
+	}
+
 protected:
 	PixData *data_{};
 	int pitchPx_{};
@@ -390,12 +453,12 @@ protected:
 
 	static void convertRGB565ToRGBX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToRGBX8888, src);
+		dest.template writeLines<uint16_t, uint32_t>(transformLineRGB565ToRGBX8888, src);
 	}
 
 	static void convertRGB565ToBGRX8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGB565ToBGRX8888, src);
+		dest.template writeLines<uint16_t, uint32_t>(transformLineRGB565ToBGRX8888, src);
 	}
 
 	static void convertRGBX8888ToRGB888(auto dest, auto src)
@@ -420,17 +483,17 @@ protected:
 
 	static void convertRGBX8888ToRGB565(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBX8888ToRGB565, src);
+		dest.template writeLines<uint32_t, uint16_t>(transformLineRGBX8888ToRGB565, src);
 	}
 
 	static void convertRGBA8888ToBGRA8888(auto dest, auto src)
 	{
-		dest.writeTransformed(transformRGBA8888ToBGRA8888, src);
+		dest.template writeLines<uint32_t, uint32_t>(transformLineRGBA8888ToBGRA8888, src);
 	}
 
 	static void convertBGRX8888ToRGB565(auto dest, auto src)
 	{
-		dest.writeTransformed(transformBGRX8888ToRGB565, src);
+		dest.template writeLines<uint32_t, uint16_t>(transformLineBGRX8888ToRGB565, src);
 	}
 };
 
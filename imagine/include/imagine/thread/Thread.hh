@@ -99,8 +99,16 @@ using ThreadId = uint64_t;
 using CPUMask = uint32_t;
 inline constexpr int maxCPUs = 32;
 
+// Kind of CPU core to prefer on devices with heterogeneous (big.LITTLE) CPUs
+enum class CPUCoreType : uint8_t
+{
+	Any, Performance, Efficiency
+};
+
 void setThreadCPUAffinityMask(std::span<const ThreadId>, CPUMask mask);
+CPUMask threadCPUAffinityMask(ThreadId);
 void setThreadPriority(ThreadId, int nice);
+bool setThreadRealtimePriority(ThreadId, int priority); // uses SCHED_FIFO if priority > 0, otherwise normal scheduling
 void setThisThreadPriority(int nice);
 int thisThreadPriority();
 ThreadId thisThreadId();
@@ -0,0 +1,119 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/util/DelegateFunc.hh>
+#ifndef IG_USE_MODULE_STD
+#include <atomic>
+#include <concepts>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#endif
+
+namespace IG
+{
+
+struct ThreadPoolConfig
+{
+	int threads{}; // worker threads to start, threads waiting on a TaskGroup also run jobs
+	CPUMask cpuMask{}; // CPUs the workers may run on, 0 for any
+	int nice{}; // scheduling priority of the workers
+};
+
+// Counts the jobs submitted with it so the submitter can wait on all of them
+class TaskGroup
+{
+public:
+	TaskGroup() = default;
+	bool isDone() const { return pending.load(std::memory_order::acquire) == 1; }
+
+private:
+	// starts at 1 for the waiting thread so the count only reaches 0 once wait() has been called,
+	// the job dropping it to 0 then releases done as its last access to the group
+	std::atomic_int pending{1};
+	binary_semaphore done{0};
+
+	friend class ThreadPool;
+};
+
+// Worker threads that each own a job queue. A worker runs the newest job from its own
+// queue first and steals the oldest one from another worker when its queue is empty, so
+// jobs submitted by a job stay on the same CPU while uneven work is still balanced.
+
+class ThreadPool
+{
+public:
+	using Job = DelegateFuncS<sizeof(void*) * 4, void()>;
+
+	ThreadPool() = default;
+	ThreadPool(ThreadPoolConfig config) { start(config); }
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool &operator=(const ThreadPool&) = delete;
+	~ThreadPool() { stop(); }
+	void start(ThreadPoolConfig);
+	void stop();
+	void run(TaskGroup &, Job);
+	void wait(TaskGroup &);
+	int threads() const { return workerCount; }
+	std::span<const ThreadId> threadIds() const { return {threadIds_.get(), size_t(workerCount)}; }
+	void setCPUAffinityMask(CPUMask mask) { setThreadCPUAffinityMask(threadIds(), mask); }
+	explicit operator bool() const { return workerCount; }
+
+	// Runs f(0) to f(count - 1) in parallel with the calling thread taking part
+	void parallelFor(int count, std::invocable<int> auto &&f)
+	{
+		TaskGroup group;
+		for(int i = 1; i < count; i++)
+		{
+			run(group, [&f, i]{ f(i); });
+		}
+		if(count > 0)
+			f(0);
+		wait(group);
+	}
+
+private:
+	struct QueuedJob
+	{
+		Job job;
+		TaskGroup *group{};
+	};
+
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<QueuedJob> jobs;
+		std::thread thread;
+	};
+
+	std::unique_ptr<Worker[]> workers;
+	std::unique_ptr<ThreadId[]> threadIds_;
+	counting_semaphore<0x7FFFFFFF> workSem{0};
+	std::atomic_bool stopping{};
+	std::atomic_uint nextQueue{};
+	int workerCount{};
+
+	bool runNextJob(int startIdx, bool ownsQueue);
+	static void runJob(QueuedJob &);
+	int callingWorkerIdx() const;
+};
+
+}
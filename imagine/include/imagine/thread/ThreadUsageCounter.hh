@@ -0,0 +1,53 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/memory/UniqueFileDescriptor.hh>
+#ifndef IG_USE_MODULE_STD
+#include <optional>
+#endif
+
+namespace IG
+{
+
+struct ThreadUsage
+{
+	Nanoseconds cpuTime{};
+	std::optional<uint64_t> migrations; // times the thread moved to another CPU, if the kernel allows counting them
+};
+
+// Reads the CPU time a thread has used and how often the scheduler migrated it,
+// using perf software events when available and the thread's schedstat otherwise
+
+class ThreadUsageCounter
+{
+public:
+	constexpr ThreadUsageCounter() = default;
+	ThreadUsageCounter(ThreadId);
+	ThreadUsage usage() const;
+	ThreadId threadId() const { return id; }
+	explicit operator bool() const { return id; }
+
+private:
+	ThreadId id{};
+	UniqueFileDescriptor cpuClockFd;
+	UniqueFileDescriptor migrationsFd;
+};
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+// Encoder & decoder for the LZ4 block format, for fast compression of in-memory data like save states.
+// The output is compatible with the reference LZ4 library's LZ4_decompress_safe().
+
+#ifndef IG_USE_MODULE_STD
+#include <span>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#endif
+
+namespace IG
+{
+
+constexpr size_t lz4MaxCompressedSize(size_t size) { return size + size / 255 + 16; }
+
+namespace LZ4Impl
+{
+
+constexpr size_t minMatch = 4;
+constexpr size_t lastLiterals = 5; // a block must end with at least this many literals
+constexpr size_t matchFindLimit = 12; // the last match must start at least this many bytes before the end
+constexpr size_t maxOffset = 65535;
+constexpr int hashLog = 12;
+
+inline uint32_t load32(const uint8_t *p)
+{
+	uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+constexpr uint32_t hash(uint32_t seq) { return (seq * 2654435761u) >> (32 - hashLog); }
+
+inline uint8_t *writeLength(uint8_t *out, size_t len)
+{
+	for(; len >= 255; len -= 255)
+		*out++ = 255;
+	*out++ = len;
+	return out;
+}
+
+inline bool readLength(const uint8_t *&in, const uint8_t *end, size_t &len)
+{
+	uint8_t b;
+	do
+	{
+		if(in == end) [[unlikely]]
+			return false;
+		b = *in++;
+		len += b;
+	} while(b == 255);
+	return true;
+}
+
+}
+
+// dest must hold at least lz4MaxCompressedSize(src.size()) bytes, returns the compressed size
+inline size_t compressLZ4(std::span<uint8_t> dest, std::span<const uint8_t> src)
+{
+	using namespace LZ4Impl;
+	if(dest.size() < lz4MaxCompressedSize(src.size())) [[unlikely]]
+		return 0;
+	const uint8_t *const base = src.data();
+	const uint8_t *const end = base + src.size();
+	const uint8_t *ip = base;
+	const uint8_t *anchor = base;
+	uint8_t *out = dest.data();
+	if(src.size() > matchFindLimit)
+	{
+		const uint8_t *const matchStartLimit = end - matchFindLimit;
+		const uint8_t *const matchEndLimit = end - lastLiterals;
+		std::array<uint32_t, 1 << hashLog> table{};
+		while(ip < matchStartLimit)
+		{
+			auto seq = load32(ip);
+			auto &entry = table[hash(seq)];
+			const uint8_t *ref = base + entry;
+			entry = ip - base;
+			if(ref >= ip || size_t(ip - ref) > maxOffset || load32(ref) != seq)
+			{
+				// step faster through data that isn't matching
+				ip += 1 + ((ip - anchor) >> 6);
+				continue;
+			}
+			while(ip > anchor && ref > base && ip[-1] == ref[-1])
+			{
+				ip--;
+				ref--;
+			}
+			const uint8_t *matchEnd = ip + minMatch;
+			const uint8_t *refEnd = ref + minMatch;
+			while(matchEnd < matchEndLimit && *matchEnd == *refEnd)
+			{
+				matchEnd++;
+				refEnd++;
+			}
+			size_t literals = ip - anchor;
+			size_t matchLen = matchEnd - ip - minMatch;
+			uint8_t *token = out++;
+			*token = uint8_t((std::min(literals, size_t(15)) << 4) | std::min(matchLen, size_t(15)));
+			if(literals >= 15)
+				out = writeLength(out, literals - 15);
+			std::memcpy(out, anchor, literals);
+			out += literals;
+			size_t offset = ip - ref;
+			*out++ = uint8_t(offset);
+			*out++ = uint8_t(offset >> 8);
+			if(matchLen >= 15)
+				out = writeLength(out, matchLen - 15);
+			ip = anchor = matchEnd;
+			if(ip < matchStartLimit)
+				table[hash(load32(ip - 2))] = ip - 2 - base;
+		}
+	}
+	size_t literals = end - anchor;
+	*out++ = uint8_t(std::min(literals, size_t(15)) << 4);
+	if(literals >= 15)
+		out = writeLength(out, literals - 15);
+	if(literals)
+		std::memcpy(out, anchor, literals);
+	out += literals;
+	return out - dest.data();
+}
+
+// returns the uncompressed size, or 0 if the input is malformed or doesn't fit in dest
+inline size_t uncompressLZ4(std::span<uint8_t> dest, std::span<const uint8_t> src)
+{
+	using namespace LZ4Impl;
+	const uint8_t *in = src.data();
+	const uint8_t *const inEnd = in + src.size();
+	uint8_t *out = dest.data();
+	uint8_t *const outEnd = out + dest.size();
+	while(in < inEnd)
+	{
+		unsigned token = *in++;
+		size_t literals = token >> 4;
+		if(literals == 15 && !readLength(in, inEnd, literals)) [[unlikely]]
+			return 0;
+		if(size_t(inEnd - in) < literals || size_t(outEnd - out) < literals) [[unlikely]]
+			return 0;
+		std::memcpy(out, in, literals);
+		in += literals;
+		out += literals;
+		if(in == inEnd) // final sequence only has literals
+			break;
+		if(inEnd - in < 2) [[unlikely]]
+			return 0;
+		size_t offset = in[0] | (in[1] << 8);
+		in += 2;
+		if(!offset || offset > size_t(out - dest.data())) [[unlikely]]
+			return 0;
+		size_t matchLen = token & 0xF;
+		if(matchLen == 15 && !readLength(in, inEnd, matchLen)) [[unlikely]]
+			return 0;
+		matchLen += minMatch;
+		if(size_t(outEnd - out) < matchLen) [[unlikely]]
+			return 0;
+		const uint8_t *match = out - offset;
+		if(offset >= matchLen)
+		{
+			std::memcpy(out, match, matchLen);
+			out += matchLen;
+		}
+		else // overlapping copy repeats the pattern
+		{
+			for(auto e = out + matchLen; out < e;)
+				*out++ = *match++;
+		}
+	}
+	return out - dest.data();
+}
+
+}
@@ -28,9 +28,24 @@ namespace IG
 
 extern uintptr_t pageSize;
 
+struct VMemFlags
+{
+	uint8_t
+	// back the memory with transparent huge pages when the OS supports them to reduce TLB misses
+	hugePages:1{},
+	// keep the memory resident so it's never paged out, may fail due to resource limits
+	locked:1{};
+
+	constexpr bool operator==(VMemFlags const&) const = default;
+};
+
 std::span<uint8_t> vAlloc(size_t bytes);
+std::span<uint8_t> vAlloc(size_t bytes, VMemFlags);
 std::span<uint8_t> vAllocMirrored(size_t bytes);
 void vFree(std::span<uint8_t>);
+// apply flags to the whole pages of existing memory, unlocking it if locked isn't set,
+// huge pages are only effective for 2MiB aligned ranges like those returned by vAlloc()
+void vApplyFlags(std::span<uint8_t>, VMemFlags);
 
 inline uintptr_t truncPageSize(uintptr_t addr)
 {
@@ -57,9 +72,9 @@ inline auto roundPageSize(uint8_t *p)
 }
 
 template <class T>
-inline std::span<T> vNew(size_t size)
+inline std::span<T> vNew(size_t size, VMemFlags flags = {})
 {
-	auto buff = vAlloc(size * sizeof(T));
+	auto buff = vAlloc(size * sizeof(T), flags);
 	return {reinterpret_cast<T*>(buff.data()), size};
 }
 
@@ -96,9 +111,9 @@ template<class T>
 using UniqueVPtr = std::unique_ptr<T[], VPtrDeleter<T>>;
 
 template<class T>
-inline UniqueVPtr<T> makeUniqueVPtr(size_t size)
+inline UniqueVPtr<T> makeUniqueVPtr(size_t size, VMemFlags flags = {})
 {
-	auto buff = vNew<T>(size);
+	auto buff = vNew<T>(size, flags);
 	return {buff.data(), VPtrDeleter<T>{buff.size()}};
 }
 
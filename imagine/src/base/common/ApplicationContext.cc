@@ -437,6 +437,20 @@ void ApplicationContext::setSwappedConfirmKeys(std::optional<bool> opt)
 	return mask;
 }
 
+CPUMask ApplicationContext::cpuMask(CPUCoreType type) const
+{
+	if(type == CPUCoreType::Any)
+		return 0;
+	auto perfMask = performanceCPUMask();
+	if(!perfMask) // all cores are the same type
+		return 0;
+	if(type == CPUCoreType::Performance)
+		return perfMask;
+	auto cpus = cpuCount();
+	CPUMask allMask = cpus >= maxCPUs ? ~CPUMask{} : CPUMask(bit(cpus) - 1);
+	return allMask & ~perfMask;
+}
+
 [[gnu::weak]] PerformanceHintManager ApplicationContext::performanceHintManager() { return {}; }
 
 [[gnu::weak]] GameManager ApplicationContext::gameManager() { return {}; }
@@ -150,6 +150,11 @@ bool DrawContextSupport::hasImmutableBufferStorage() const
 	#endif
 }
 
+bool DrawContextSupport::hasProgramBinaries() const
+{
+	return glGetProgramBinary && glProgramBinary;
+}
+
 bool DrawContextSupport::hasMemoryBarriers() const
 {
 	return false;
@@ -39,7 +39,7 @@ bool GLTask::makeGLContext(GLTaskConfig config)
 		threadId_ = thisThreadId();
 		auto &glManager = *config.glManagerPtr;
 		glManager.bindAPI(glAPI);
-		context = makeGLContext(glManager, config.bufferConfig);
+		context = makeGLContext(glManager, config.bufferConfig, config.shareContext);
 		if(!context) [[unlikely]]
 		{
 			sem.release();
@@ -156,12 +156,13 @@ static GLContextAttributes makeGLContextAttributes(GL::Version version)
 	return glAttr;
 }
 
-static GLContext makeVersionedGLContext(GLManager &mgr, GLBufferConfig config, GL::Version version)
+static GLContext makeVersionedGLContext(GLManager &mgr, GLBufferConfig config, GL::Version version,
+	NativeGLContext shareContext)
 {
 	auto glAttr = makeGLContextAttributes(version);
 	try
 	{
-		return mgr.makeContext(glAttr, config);
+		return mgr.makeContext(glAttr, config, shareContext);
 	}
 	catch(...)
 	{
@@ -169,24 +170,24 @@ static GLContext makeVersionedGLContext(GLManager &mgr, GLBufferConfig config, G
 	}
 }
 
-GLContext GLTask::makeGLContext(GLManager &mgr, GLBufferConfig bufferConf)
+GLContext GLTask::makeGLContext(GLManager &mgr, GLBufferConfig bufferConf, NativeGLContext shareContext)
 {
 	if constexpr((bool)Config::Gfx::OPENGL_ES)
 	{
 		if(bufferConf.maySupportGLES(mgr.display(), 3))
 		{
-			auto ctx = makeVersionedGLContext(mgr, bufferConf, {3});
+			auto ctx = makeVersionedGLContext(mgr, bufferConf, {3}, shareContext);
 			if(ctx)
 			{
 				return ctx;
 			}
 		}
 		// fall back to OpenGL ES 2.0
-		return makeVersionedGLContext(mgr, bufferConf, {2});
+		return makeVersionedGLContext(mgr, bufferConf, {2}, shareContext);
 	}
 	else
 	{
-		auto ctx = makeVersionedGLContext(mgr, bufferConf, {3, 3});
+		auto ctx = makeVersionedGLContext(mgr, bufferConf, {3, 3}, shareContext);
 		if(ctx)
 		{
 			return ctx;
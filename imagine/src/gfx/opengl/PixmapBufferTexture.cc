@@ -56,7 +56,13 @@ PixmapBufferTexture::PixmapBufferTexture(RendererTask& r, TextureConfig config,
 
 static size_t bufferCount(TextureBufferImageMode mode)
 {
-	return mode == TextureBufferImageMode::Single ? 1 : 2;
+	switch(mode)
+	{
+		case TextureBufferImageMode::Single: return 1;
+		case TextureBufferImageMode::Double: return 2;
+		case TextureBufferImageMode::Triple: return 3;
+	}
+	unreachable();
 }
 
 static bool hasPersistentBufferMapping(const Renderer &r)
@@ -203,9 +209,54 @@ int PixmapBufferTexture::buffers() const
 	return visit([&](auto& t){ return t.buffers(); }, directTex);
 }
 
+bool PixmapBufferTexture::updateFromNewestBuffer(bool countDuplicate)
+{
+	return visit([&](auto& t)
+	{
+		if constexpr(requires {t.updateFromNewestBuffer(countDuplicate);})
+			return t.updateFromNewestBuffer(countDuplicate);
+		else
+			return false;
+	}, directTex);
+}
+
+TextureBufferFrameStats PixmapBufferTexture::takeFrameStats()
+{
+	return visit([&](auto& t)
+	{
+		if constexpr(requires {t.takeFrameStats();})
+			return t.takeFrameStats();
+		else
+			return TextureBufferFrameStats{};
+	}, directTex);
+}
+
+bool PixmapBufferTexture::usesMailbox() const
+{
+	return visit([&](auto& t)
+	{
+		if constexpr(requires {t.imageMode();})
+			return t.imageMode() == TextureBufferImageMode::Triple;
+		else
+			return false;
+	}, directTex);
+}
+
 template<class Impl, class BufferInfo>
 bool GLTextureStorage<Impl, BufferInfo>::setFormat(PixmapDesc desc, ColorSpace colorSpace, TextureSamplerConfig samplerConf)
 {
+	if(mailbox)
+	{
+		// reset on the renderer thread so it stops reading the old buffers before they're replaced
+		task().runSync(
+			[this]()
+			{
+				mailbox->reset();
+				if constexpr(requires {static_cast<Impl*>(this)->clearUploadFences();})
+					static_cast<Impl*>(this)->clearUploadFences();
+			});
+		bufferIdx = 0;
+	}
 	static_cast<Impl*>(this)->initBuffer(desc, imageMode());
 	return Texture::setFormat(desc, 1, colorSpace, samplerConf);
 }
@@ -234,14 +285,49 @@ LockedTextureBuffer GLTextureStorage<Impl, BufferInfo>::lock(TextureBufferFlags
 template<class Impl, class BufferInfo>
 void GLTextureStorage<Impl, BufferInfo>::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
 {
+	if(mailbox)
+	{
+		// upload is deferred to the renderer calling updateFromNewestBuffer()
+		if(lockBuff) [[likely]]
+			bufferIdx = mailbox->publish(bufferIdx);
+		return;
+	}
 	Texture::unlock(lockBuff, writeFlags);
 	swapBuffer();
 }
 
+template<class Impl, class BufferInfo>
+bool GLTextureStorage<Impl, BufferInfo>::updateFromNewestBuffer(bool countDuplicate)
+{
+	if(!mailbox || !texName())
+		return false;
+	if constexpr(requires {static_cast<Impl*>(this)->waitForUpload(0);})
+	{
+		if(mailbox->hasNewBuffer())
+			static_cast<Impl*>(this)->waitForUpload(mailbox->frontIndex());
+	}
+	auto idx = mailbox->acquire(countDuplicate);
+	if(idx == -1)
+		return false;
+	auto bufferInfo = info[idx];
+	PixmapView pix{pixmapDesc(), bufferInfo.data};
+	GLuint pbo{};
+	if constexpr(requires {static_cast<Impl*>(this)->pbo();})
+	{
+		pbo = static_cast<Impl*>(this)->pbo();
+	}
+	writeBufferInGL(renderer(), texName(), pix, bufferInfo.dataStoreOffset(), {}, pbo, 0);
+	if constexpr(requires {static_cast<Impl*>(this)->fenceUpload(0);})
+	{
+		static_cast<Impl*>(this)->fenceUpload(idx);
+	}
+	return true;
+}
+
 template<class Impl, class BufferInfo>
 void GLTextureStorage<Impl, BufferInfo>::writeAligned(PixmapView pixmap, int assumeAlign, TextureWriteFlags writeFlags)
 {
-	if(renderer().support.hasUnpackRowLength || !pixmap.isPadded())
+	if(!mailbox && (renderer().support.hasUnpackRowLength || !pixmap.isPadded()))
 	{
 		Texture::writeAligned(0, pixmap, {}, assumeAlign, writeFlags);
 	}
@@ -270,8 +356,10 @@ void GLSystemMemoryStorage::initBuffer(PixmapDesc desc, TextureBufferImageMode i
 	auto fullBytes = bytes * bufferCount(imageMode);
 	storage = std::make_unique<char[]>(fullBytes);
 	log.info("allocated system memory with buffers:{} size:{} data:{}", bufferCount(imageMode), bytes, storage.get());
-	info[0] = {storage.get()};
-	info[1] = {bufferCount(imageMode) == 1 ? nullptr : storage.get() + bytes};
+	for(auto i : iotaCount(info.size()))
+	{
+		info[i] = {i < bufferCount(imageMode) ? storage.get() + bytes * i : nullptr};
+	}
 }
 
 GLPixelBufferStorage::GLPixelBufferStorage(RendererTask &rTask, TextureConfig config, TextureBufferImageMode imageMode):
@@ -319,12 +407,12 @@ void GLPixelBufferStorage::initBuffer(PixmapDesc desc, TextureBufferImageMode im
 	if(bufferPtr)
 	{
 		log.info("allocated PBO:{} with buffers:{} size:{} data:{}", pixelBuff.get(), bufferCount(imageMode), bufferBytes, bufferPtr);
-		info[0] = {bufferPtr, nullptr};
-		if(bufferCount(imageMode) == 1)
-			info[1] = {nullptr};
-		else
+		for(auto i : iotaCount(info.size()))
 		{
-			info[1] = {bufferPtr + bufferBytes, (void *)(uintptr_t)bufferBytes};
+			if(i < bufferCount(imageMode))
+				info[i] = {bufferPtr + bufferBytes * i, (void *)(uintptr_t)(bufferBytes * i)};
+			else
+				info[i] = {};
 		}
 	}
 	else [[unlikely]]
@@ -333,6 +421,40 @@ void GLPixelBufferStorage::initBuffer(PixmapDesc desc, TextureBufferImageMode im
 	}
 }
 
+void GLPixelBufferStorage::waitForUpload(int idx)
+{
+	auto sync = uploadFences[idx].release();
+	if(!sync)
+		return;
+	auto &r = renderer();
+	auto dpy = r.glDisplay();
+	r.support.clientWaitSync(dpy, sync, SYNC_FLUSH_COMMANDS_BIT, SyncFence::IGNORE_TIMEOUT.count());
+	r.support.deleteSync(dpy, sync);
+}
+
+void GLPixelBufferStorage::fenceUpload(int idx)
+{
+	auto &r = renderer();
+	if(!r.support.hasSyncFences()) [[unlikely]]
+		return;
+	uploadFences[idx] = {r.support.fenceSync(r.glDisplay()), GLSyncDeleter{&task()}};
+}
+
+void GLPixelBufferStorage::clearUploadFences()
+{
+	auto &r = renderer();
+	for(auto &f : uploadFences)
+	{
+		if(auto sync = f.release())
+			r.support.deleteSync(r.glDisplay(), sync);
+	}
+}
+
+void GLSyncDeleter::operator()(GLsync sync) const
+{
+	rTask->deleteSyncFence(sync);
+}
+
 template class GLTextureStorage<GLSystemMemoryStorage, GLSystemMemoryBufferInfo>;
 template class GLTextureStorage<GLPixelBufferStorage, GLPixelBufferInfo>;
 
@@ -61,6 +61,34 @@ static bool linkGLProgram(GLuint program)
 	return true;
 }
 
+// On-demand compiles run on a context sharing objects with the renderer so drawing isn't blocked,
+// startup ones stay on the renderer to avoid creating the extra context
+static GLTask &compileTask(RendererTask &rTask, bool background)
+{
+	if(!background)
+		return rTask;
+	return rTask.renderer().shaderCompileTask();
+}
+
+// Objects made on another context must be complete before the renderer can use them
+static void finishForOtherContexts(const GLTask &task, const RendererTask &rTask)
+{
+	if(&task != &rTask)
+		glFinish();
+}
+
+static void getUniformLocations(GLuint program, std::span<UniformLocationDesc> uniformDescs)
+{
+	for(auto desc : uniformDescs)
+	{
+		GL::runChecked([&]()
+		{
+			*desc.locationPtr = glGetUniformLocation(program, desc.name);
+		}, log, Renderer::checkGLErrors, "glGetUniformLocation()");
+		log.info("uniform:{} location:{}", desc.name, *desc.locationPtr);
+	}
+}
+
 void destroyGLShader(RendererTask &rTask, NativeShader s)
 {
 	if(!s)
@@ -100,8 +128,9 @@ Program::Program(RendererTask &rTask, NativeShader vShader, NativeShader fShader
 	ProgramFlags flags, std::span<UniformLocationDesc> uniformDescs)
 {
 	GLuint programOut{};
-	rTask.runSync(
-		[=, &programOut]()
+	auto &task = compileTask(rTask, flags.backgroundCompile);
+	task.runSync(
+		[=, &task, &rTask, &programOut]()
 		{
 			auto program = makeGLProgram(vShader, fShader);
 			if(!program) [[unlikely]]
@@ -124,6 +153,11 @@ Program::Program(RendererTask &rTask, NativeShader vShader, NativeShader fShader
 					glBindAttribLocation(program, VATTR_TEX_UV, "texUV");
 				}, log, Renderer::checkGLErrors, "glBindAttribLocation(..., texUV)");
 			}
+			auto &support = rTask.renderer().support;
+			if(flags.retrievableBinary && support.hasProgramBinaries() && support.glProgramParameteri)
+			{
+				support.glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+			}
 			if(!linkGLProgram(program))
 			{
 				glDeleteProgram(program);
@@ -132,19 +166,67 @@ Program::Program(RendererTask &rTask, NativeShader vShader, NativeShader fShader
 			log.info("made program:{}", program);
 			glDetachShader(program, vShader);
 			glDetachShader(program, fShader);
-			for(auto desc : uniformDescs)
+			getUniformLocations(program, uniformDescs);
+			finishForOtherContexts(task, rTask);
+			programOut = program;
+		});
+	program_ = {programOut, {&rTask}};
+}
+
+Program::Program(RendererTask &rTask, const ProgramBinary &bin, ProgramFlags flags, std::span<UniformLocationDesc> uniformDescs)
+{
+	if(!rTask.renderer().support.hasProgramBinaries() || !bin) [[unlikely]]
+		return;
+	GLuint programOut{};
+	auto &task = compileTask(rTask, flags.backgroundCompile);
+	task.runSync(
+		[&, uniformDescs]()
+		{
+			auto &support = rTask.renderer().support;
+			auto program = glCreateProgram();
+			if(!program) [[unlikely]]
+				return;
+			support.glProgramBinary(program, bin.format, bin.data.data(), bin.data.size());
+			GLint success;
+			glGetProgramiv(program, GL_LINK_STATUS, &success);
+			if(success == GL_FALSE)
 			{
-				GL::runChecked([&]()
-				{
-					*desc.locationPtr = glGetUniformLocation(program, desc.name);
-				}, log, Renderer::checkGLErrors, "glGetUniformLocation()");
-				log.info("uniform:{} location:{}", desc.name, *desc.locationPtr);
+				// driver updates can invalidate old binaries, caller should rebuild from source
+				log.info("program binary format:{:X} rejected by driver", bin.format);
+				glDeleteProgram(program);
+				return;
 			}
+			log.info("made program:{} from {} byte binary", program, bin.data.size());
+			getUniformLocations(program, uniformDescs);
+			finishForOtherContexts(task, rTask);
 			programOut = program;
 		});
 	program_ = {programOut, {&rTask}};
 }
 
+ProgramBinary Program::binary()
+{
+	ProgramBinary bin;
+	if(!program_ || !task().renderer().support.hasProgramBinaries())
+		return bin;
+	task().runSync(
+		[&, program = (GLuint)program_]()
+		{
+			auto &support = task().renderer().support;
+			GLint size{};
+			glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+			if(size <= 0)
+				return;
+			bin.data.resize(size);
+			GLsizei length{};
+			GLenum format{};
+			support.glGetProgramBinary(program, size, &length, &format, bin.data.data());
+			bin.data.resize(length);
+			bin.format = format;
+		});
+	return bin;
+}
+
 Program::operator bool() const
 {
 	return program_.get();
@@ -250,7 +332,7 @@ void Program::uniform(int loc, Mat4 mat)
 	});
 }
 
-static GLuint makeGLShader(RendererTask &rTask, std::span<std::string_view> srcs, ShaderType type)
+static GLuint makeGLShader(RendererTask &rTask, std::span<std::string_view> srcs, ShaderType type, bool background)
 {
 	if(srcs.size() > maxSourceStrings) [[unlikely]]
 	{
@@ -258,8 +340,9 @@ static GLuint makeGLShader(RendererTask &rTask, std::span<std::string_view> srcs
 		return 0;
 	}
 	GLuint shaderOut{};
-	rTask.runSync(
-		[&shaderOut, srcs, type]()
+	auto &task = compileTask(rTask, background);
+	task.runSync(
+		[&shaderOut, &task, &rTask, srcs, type]()
 		{
 			auto shader = glCreateShader((GLenum)type);
 			StaticArrayList<const GLchar*, maxSourceStrings> srcStrings;
@@ -294,6 +377,7 @@ static GLuint makeGLShader(RendererTask &rTask, std::span<std::string_view> srcs
 			}
 			else
 			{
+				finishForOtherContexts(task, rTask);
 				shaderOut = shader;
 			}
 		});
@@ -302,7 +386,7 @@ static GLuint makeGLShader(RendererTask &rTask, std::span<std::string_view> srcs
 	return shaderOut;
 }
 
-static GLuint makeCompatGLShader(RendererTask &rTask, std::span<std::string_view> srcs, ShaderType type)
+static GLuint makeCompatGLShader(RendererTask &rTask, std::span<std::string_view> srcs, ShaderType type, bool background)
 {
 	if(auto srcCount = srcs.size() + 2;
 		srcCount > maxSourceStrings) [[unlikely]]
@@ -337,42 +421,43 @@ static GLuint makeCompatGLShader(RendererTask &rTask, std::span<std::string_view
 	{
 		compatSrcs.emplace_back(s);
 	}
-	return makeGLShader(rTask, compatSrcs, type);
+	return makeGLShader(rTask, compatSrcs, type, background);
 }
 
-static GLuint makeGLShader(RendererTask &rTask, std::span<std::string_view> srcs, ShaderType type, Shader::CompileMode mode)
+static GLuint makeGLShader(RendererTask &rTask, std::span<std::string_view> srcs, ShaderType type,
+	Shader::CompileMode mode, bool background)
 {
 	if(mode == Shader::CompileMode::COMPAT)
-		return makeCompatGLShader(rTask, srcs, type);
+		return makeCompatGLShader(rTask, srcs, type, background);
 	else
-		return makeGLShader(rTask, srcs, type);
+		return makeGLShader(rTask, srcs, type, background);
 }
 
-Shader::Shader(RendererTask &rTask, std::span<std::string_view> srcs, ShaderType type, CompileMode mode):
-	UniqueGLShader{makeGLShader(rTask, srcs, type, mode), {&rTask}}
+Shader::Shader(RendererTask &rTask, std::span<std::string_view> srcs, ShaderType type, CompileMode mode, bool backgroundCompile):
+	UniqueGLShader{makeGLShader(rTask, srcs, type, mode, backgroundCompile), {&rTask}}
 {}
 
-Shader::Shader(RendererTask &rTask, std::string_view src, ShaderType type, CompileMode mode):
-	Shader{rTask, {&src, 1}, type, mode} {}
+Shader::Shader(RendererTask &rTask, std::string_view src, ShaderType type, CompileMode mode, bool backgroundCompile):
+	Shader{rTask, {&src, 1}, type, mode, backgroundCompile} {}
 
-Shader Renderer::makeShader(std::span<std::string_view> srcs, ShaderType type)
+Shader Renderer::makeShader(std::span<std::string_view> srcs, ShaderType type, bool backgroundCompile)
 {
-	return {task(), srcs, type, Shader::CompileMode::NORMAL};
+	return {task(), srcs, type, Shader::CompileMode::NORMAL, backgroundCompile};
 }
 
-Shader Renderer::makeShader(std::string_view src, ShaderType type)
+Shader Renderer::makeShader(std::string_view src, ShaderType type, bool backgroundCompile)
 {
-	return {task(), {&src, 1}, type, Shader::CompileMode::NORMAL};
+	return {task(), {&src, 1}, type, Shader::CompileMode::NORMAL, backgroundCompile};
 }
 
-Shader Renderer::makeCompatShader(std::span<std::string_view> srcs, ShaderType type)
+Shader Renderer::makeCompatShader(std::span<std::string_view> srcs, ShaderType type, bool backgroundCompile)
 {
-	return {task(), srcs, type, Shader::CompileMode::COMPAT};
+	return {task(), srcs, type, Shader::CompileMode::COMPAT, backgroundCompile};
 }
 
-Shader Renderer::makeCompatShader(std::string_view src, ShaderType type)
+Shader Renderer::makeCompatShader(std::string_view src, ShaderType type, bool backgroundCompile)
 {
-	return {task(), {&src, 1}, type, Shader::CompileMode::COMPAT};
+	return {task(), {&src, 1}, type, Shader::CompileMode::COMPAT, backgroundCompile};
 }
 
 }
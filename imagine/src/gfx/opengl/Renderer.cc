@@ -53,15 +53,16 @@ Renderer::~Renderer()
 GLRenderer::GLRenderer(ApplicationContext ctx):
 	glManager{ctx.nativeDisplayConnection(), glAPI},
 	mainTask{ctx, "Main GL Context Messages", *static_cast<Renderer*>(this)},
+	compileTask{ctx, "Shader Compile GL Context Messages"},
 	releaseShaderCompilerEvent
 	{
 		{.debugLabel = "GLRenderer::releaseShaderCompilerEvent"},
-		[&task = mainTask, ctx]
+		[this, ctx]
 		{
 			if(!ctx.isRunning())
 				return;
 			log.info("automatically releasing shader compiler");
-			task.releaseShaderCompiler();
+			static_cast<Renderer*>(this)->releaseShaderCompiler();
 		}
 	}
 {
@@ -260,9 +261,37 @@ bool Renderer::canRenderToMultiplePixelFormats() const
 	return glManager.hasNoConfigContext();
 }
 
+GLTask &GLRenderer::shaderCompileTask()
+{
+	if(compileTask)
+		return compileTask;
+	if(compileTaskFailed)
+		return mainTask;
+	// create on first use since not every app compiles shaders after startup
+	GLTaskConfig conf
+	{
+		.glManagerPtr = &glManager,
+		.bufferConfig = mainTask.glBufferConfig(),
+		.shareContext = mainTask.glContext(),
+	};
+	if(!compileTask.makeGLContext(conf)) [[unlikely]]
+	{
+		log.warn("unable to create shared context for shader compiles, using main context");
+		compileTaskFailed = true;
+		return mainTask;
+	}
+	return compileTask;
+}
+
 void Renderer::releaseShaderCompiler()
 {
-	task().releaseShaderCompiler();
+	// on-demand compiles run on the shared context once it exists
+	auto &task = compileTask ? compileTask : static_cast<GLTask&>(mainTask);
+	task.run(
+		[]()
+		{
+			glReleaseShaderCompiler();
+		});
 }
 
 void Renderer::autoReleaseShaderCompiler()
@@ -270,6 +299,16 @@ void Renderer::autoReleaseShaderCompiler()
 	releaseShaderCompilerEvent.notify();
 }
 
+bool Renderer::supportsProgramBinaries() const
+{
+	return support.hasProgramBinaries();
+}
+
+std::string_view Renderer::driverName() const
+{
+	return glDriverName;
+}
+
 ClipRect Renderer::makeClipRect(const Window &win, IG::WindowRect rect)
 {
 	int x = rect.x;
@@ -596,6 +635,10 @@ static void printFeatures(DrawContextSupport support)
 	{
 		featuresStr.append(" [PBOs]");
 	}
+	if(support.hasProgramBinaries())
+	{
+		featuresStr.append(" [Program Binaries]");
+	}
 	if(!Config::Gfx::OPENGL_ES || (Config::Gfx::OPENGL_ES && (bool)support.glMapBufferRange))
 	{
 		featuresStr.append(" [Map Buffer Range]");
@@ -755,6 +798,23 @@ void GLRenderer::setupVAOFuncs([[maybe_unused]] bool oes)
 	#endif
 }
 
+void GLRenderer::setupProgramBinaries(bool oes)
+{
+	if(support.glGetProgramBinary)
+		return;
+	if(oes)
+	{
+		glManager.loadSymbol(support.glGetProgramBinary, "glGetProgramBinaryOES");
+		glManager.loadSymbol(support.glProgramBinary, "glProgramBinaryOES");
+	}
+	else
+	{
+		glManager.loadSymbol(support.glGetProgramBinary, "glGetProgramBinary");
+		glManager.loadSymbol(support.glProgramBinary, "glProgramBinary");
+		glManager.loadSymbol(support.glProgramParameteri, "glProgramParameteri");
+	}
+}
+
 void GLRenderer::setupFenceSync()
 {
 	#if !defined CONFIG_BASE_GL_PLATFORM_EGL && defined CONFIG_GFX_OPENGL_ES
@@ -894,6 +954,10 @@ void GLRenderer::checkExtensionString(std::string_view extStr)
 	{
 		setupVAOFuncs(true);
 	}
+	else if(extStr == "GL_OES_get_program_binary")
+	{
+		setupProgramBinaries(true);
+	}
 	#endif
 	#ifndef CONFIG_GFX_OPENGL_ES
 	/*else if(string_equal(extStr, "GL_EXT_texture_filter_anisotropic"))
@@ -920,6 +984,10 @@ void GLRenderer::checkExtensionString(std::string_view extStr)
 	{
 		setupMemoryBarrier();
 	}
+	else if(extStr == "GL_ARB_get_program_binary")
+	{
+		setupProgramBinaries();
+	}
 	#endif
 }
 
@@ -952,6 +1020,7 @@ void Renderer::configureRenderer()
 			log.info("version: {} ({})", version, rendererName);
 
 			int glVer = GL::toVersion(version);
+			glDriverName = std::format("{} {}", rendererName, version);
 
 			#ifdef CONFIG_BASE_GL_PLATFORM_EGL
 			if constexpr((bool)Config::Gfx::OPENGL_ES)
@@ -967,6 +1036,10 @@ void Renderer::configureRenderer()
 				log.error("At least OpenGL 3.3 is required");
 				return;
 			}
+			if(glVer >= 41)
+			{
+				setupProgramBinaries();
+			}
 			#else
 			// core functionality
 			assume(glVer >= 20);
@@ -989,6 +1062,7 @@ void Renderer::configureRenderer()
 					setupSpecifyDrawReadBuffers();
 				support.hasUnpackRowLength = true;
 				support.useLegacyGLSL = false;
+				setupProgramBinaries();
 			}
 			if(glVer >= 31)
 			{
@@ -1003,6 +1077,18 @@ void Renderer::configureRenderer()
 			});
 			printGLExtensions();
 
+			if(support.hasProgramBinaries())
+			{
+				GLint binaryFormats{};
+				glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+				if(!binaryFormats)
+				{
+					log.info("no program binary formats supported");
+					support.glGetProgramBinary = {};
+					support.glProgramBinary = {};
+				}
+			}
+
 			GLint texSize;
 			glGetIntegerv(GL_MAX_TEXTURE_SIZE, &texSize);
 			support.textureSizeSupport.maxXSize = support.textureSizeSupport.maxYSize = texSize;
@@ -479,32 +479,8 @@ void Texture::unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags)
 		 pbo = lockBuff.pbo(), level = lockBuff.level(),
 		 shouldFreeBuffer = lockBuff.shouldFreeBuffer(), makeMipmaps]()
 		{
-			glBindTexture(GL_TEXTURE_2D, texName);
-			glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignForAddrAndPitch(nullptr, pix.pitchBytes()));
-			if(pbo)
-			{
-				assume(r.support.hasUnpackRowLength);
-				glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
-				r.support.glFlushMappedBufferRange(GL_PIXEL_UNPACK_BUFFER, (GLintptr)bufferOffset, pix.bytes());
-			}
-			else
-			{
-				if(r.support.hasUnpackRowLength)
-					glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-			}
-			GLenum format = makeGLFormat(r, pix.format());
-			GLenum dataType = makeGLDataType(pix.format());
-			GL::runChecked([&]()
-			{
-				glTexSubImage2D(GL_TEXTURE_2D, level, destPos.x, destPos.y,
-					pix.w(), pix.h(), format, dataType, bufferOffset);
-			}, log, Renderer::checkGLErrorsVerbose, "glTexSubImage2D()");
-			if(pbo)
-			{
-				glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-			}
-			else if(shouldFreeBuffer)
+			writeBufferInGL(r, texName, pix, bufferOffset, destPos, pbo, level);
+			if(!pbo && shouldFreeBuffer)
 			{
 				std::free(pix.data());
 			}
@@ -565,6 +541,36 @@ Texture::operator TextureSpan() const
 	return {this};
 }
 
+void GLTexture::writeBufferInGL(const Renderer &r, GLuint texName, PixmapView pix, const void *bufferOffset,
+	WPt destPos, GLuint pbo, int level)
+{
+	glBindTexture(GL_TEXTURE_2D, texName);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignForAddrAndPitch(nullptr, pix.pitchBytes()));
+	if(pbo)
+	{
+		assume(r.support.hasUnpackRowLength);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+		r.support.glFlushMappedBufferRange(GL_PIXEL_UNPACK_BUFFER, (GLintptr)bufferOffset, pix.bytes());
+	}
+	else
+	{
+		if(r.support.hasUnpackRowLength)
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	}
+	GLenum format = makeGLFormat(r, pix.format());
+	GLenum dataType = makeGLDataType(pix.format());
+	GL::runChecked([&]()
+	{
+		glTexSubImage2D(GL_TEXTURE_2D, level, destPos.x, destPos.y,
+			pix.w(), pix.h(), format, dataType, bufferOffset);
+	}, log, Renderer::checkGLErrorsVerbose, "glTexSubImage2D()");
+	if(pbo)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+}
+
 GLuint GLTexture::texName() const
 {
 	return texName_.get();
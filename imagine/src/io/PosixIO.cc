@@ -285,11 +285,11 @@ IOBuffer PosixIO::releaseBuffer()
 
 IOBuffer PosixIO::mapRange(off_t start, size_t size, IOMapFlags mapFlags)
 {
-	int flags = MAP_SHARED;
+	int flags = mapFlags.privateCopy ? MAP_PRIVATE : MAP_SHARED;
 	if(mapFlags.populatePages)
 		flags |= MAP_POPULATE;
 	int prot = PROT_READ;
-	if(mapFlags.write)
+	if(mapFlags.write || mapFlags.privateCopy)
 		prot |= PROT_WRITE;
 	void *data = mmap(nullptr, size, prot, flags, fd(), start);
 	if(data == MAP_FAILED) [[unlikely]]
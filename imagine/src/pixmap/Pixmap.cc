@@ -20,6 +20,35 @@ namespace IG
 
 using RGBTripleArray = std::array<unsigned char, 3>;
 
+// GCC/Clang vector extensions, lowered to SSE2/AVX2 on x86 and NEON on ARM depending on the target
+// 32-byte vectors are only used as locals so their ABI never depends on whether AVX is enabled
+using u32x8 = uint32_t __attribute__((vector_size(32)));
+using u32x4 = uint32_t __attribute__((vector_size(16)));
+using u16x8 = uint16_t __attribute__((vector_size(16)));
+constexpr size_t vecPixels = 8;
+
+static void loadVec(auto &v, const void *p)
+{
+	std::memcpy(&v, p, sizeof(v));
+}
+
+static void storeVec(void *p, const auto &v)
+{
+	std::memcpy(p, &v, sizeof(v));
+}
+
+// Channel depth conversions, written with multiply-shift instead of division so they
+// work on both scalars and 16-bit vector lanes, giving results identical to the rounded divisions:
+// 8 -> 5 bits: (c * 31 + 127) / 255, or (c * 62 + 255) / 510 for the red channel
+// 8 -> 6 bits: (c * 63 + 127) / 255
+// 5 -> 8 bits: (c * 255 + 15) / 31
+// 6 -> 8 bits: (c * 255 + 31) / 63
+static auto red8To5(auto c) { return (c * 249 + 1016) >> 11; }
+static auto chan8To5(auto c) { return (c * 249 + 1024) >> 11; }
+static auto chan8To6(auto c) { return (c * 253 + 512) >> 10; }
+static auto chan5To8(auto c) { return (c * 527 + 23) >> 6; }
+static auto chan6To8(auto c) { return (c * 259 + 33) >> 6; }
+
 RGBTripleArray transformRGB565ToRGB888(uint16_t p)
 {
 	unsigned b = p       & 0x1F;
@@ -27,9 +56,9 @@ RGBTripleArray transformRGB565ToRGB888(uint16_t p)
 	unsigned r = p >> 11 & 0x1F;
 	return RGBTripleArray
 		{
-			uint8_t((r * 255 + 15) / 31),
-			uint8_t((g * 255 + 31) / 63),
-			uint8_t((b * 255 + 15) / 31)
+			uint8_t(chan5To8(r)),
+			uint8_t(chan6To8(g)),
+			uint8_t(chan5To8(b))
 		};
 }
 
@@ -38,14 +67,29 @@ uint16_t transformRGB888ToRGB565(RGBTripleArray p)
 	unsigned r = p[0];
 	unsigned g = p[1];
 	unsigned b = p[2];
-	return ((r * (31 * 2) + 255) / (255 * 2)) << 11 |
-			((g * 63 + 127) / 255) << 5 |
-			((b * 31 + 127) / 255);
+	return red8To5(r) << 11 | chan8To6(g) << 5 | chan8To5(b);
 }
 
-uint32_t transformRGBA8888ToBGRA8888(uint32_t p)
+static auto swapRB(auto p)
+{
+	return (p & 0xFF00FF00) | ((p & 0xFF0000) >> 16) | ((p & 0x0000FF) << 16);
+}
+
+uint32_t transformRGBA8888ToBGRA8888(uint32_t p) { return swapRB(p); }
+
+void transformLineRGBA8888ToBGRA8888(const uint32_t *src, size_t count, uint32_t *dest)
 {
-	return (p & 0xFF000000) | ((p & 0xFF0000) >> 16) | (p & 0x00FF00) | ((p & 0x0000FF) << 16);
+	size_t i = 0;
+	for(; i + 4 <= count; i += 4)
+	{
+		u32x4 p;
+		loadVec(p, src + i);
+		storeVec(dest + i, swapRB(p));
+	}
+	for(; i < count; i++)
+	{
+		dest[i] = swapRB(src[i]);
+	}
 }
 
 template <bool BGR_SWAP = false>
@@ -55,14 +99,35 @@ static uint16_t transformRGBX8888ToRGB565Impl(uint32_t p)
 	unsigned g = p >>  8 & 0xFF;
 	unsigned b = p >> 16 & 0xFF;
 	if constexpr(BGR_SWAP) { std::swap(r, b); }
-	return ((r * (31 * 2) + 255) / (255 * 2)) << 11 |
-			((g * 63 + 127) / 255) << 5 |
-			((b * 31 + 127) / 255);
+	return red8To5(r) << 11 | chan8To6(g) << 5 | chan8To5(b);
 }
 
 uint16_t transformRGBX8888ToRGB565(uint32_t p) { return transformRGBX8888ToRGB565Impl(p); }
 uint16_t transformBGRX8888ToRGB565(uint32_t p) { return transformRGBX8888ToRGB565Impl<true>(p); }
 
+template <bool BGR_SWAP = false>
+static void transformLineRGBX8888ToRGB565Impl(const uint32_t *src, size_t count, uint16_t *dest)
+{
+	size_t i = 0;
+	for(; i + vecPixels <= count; i += vecPixels)
+	{
+		u32x8 p;
+		loadVec(p, src + i);
+		auto r = __builtin_convertvector(p       & 0xFF, u16x8);
+		auto g = __builtin_convertvector(p >>  8 & 0xFF, u16x8);
+		auto b = __builtin_convertvector(p >> 16 & 0xFF, u16x8);
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		storeVec(dest + i, u16x8(red8To5(r) << 11 | chan8To6(g) << 5 | chan8To5(b)));
+	}
+	for(; i < count; i++)
+	{
+		dest[i] = transformRGBX8888ToRGB565Impl<BGR_SWAP>(src[i]);
+	}
+}
+
+void transformLineRGBX8888ToRGB565(const uint32_t *src, size_t count, uint16_t *dest) { transformLineRGBX8888ToRGB565Impl(src, count, dest); }
+void transformLineBGRX8888ToRGB565(const uint32_t *src, size_t count, uint16_t *dest) { transformLineRGBX8888ToRGB565Impl<true>(src, count, dest); }
+
 template <bool BGR_SWAP = false>
 static RGBTripleArray transformRGBX8888ToRGB888Impl(uint32_t p)
 {
@@ -88,14 +153,38 @@ static uint32_t transformRGB565ToRGBX8888Impl(uint16_t p)
 	unsigned g = p >>  5 & 0x3F;
 	unsigned r = p >> 11 & 0x1F;
 	if constexpr(BGR_SWAP) { std::swap(r, b); }
-	return ((b * 255 + 15) / 31) << 16 |
-			((g * 255 + 31) / 63) << 8 |
-			((r * 255 + 15) / 31);
+	return chan5To8(b) << 16 | chan6To8(g) << 8 | chan5To8(r);
 }
 
 uint32_t transformRGB565ToRGBX8888(uint16_t p) { return transformRGB565ToRGBX8888Impl(p); }
 uint32_t transformRGB565ToBGRX8888(uint16_t p) { return transformRGB565ToRGBX8888Impl<true>(p); }
 
+template <bool BGR_SWAP = false>
+static void transformLineRGB565ToRGBX8888Impl(const uint16_t *src, size_t count, uint32_t *dest)
+{
+	size_t i = 0;
+	for(; i + vecPixels <= count; i += vecPixels)
+	{
+		u16x8 p;
+		loadVec(p, src + i);
+		u16x8 b = p       & 0x1F;
+		u16x8 g = p >>  5 & 0x3F;
+		u16x8 r = p >> 11 & 0x1F;
+		if constexpr(BGR_SWAP) { std::swap(r, b); }
+		u32x8 out = __builtin_convertvector(u16x8(chan5To8(b)), u32x8) << 16 |
+			__builtin_convertvector(u16x8(chan6To8(g)), u32x8) << 8 |
+			__builtin_convertvector(u16x8(chan5To8(r)), u32x8);
+		storeVec(dest + i, out);
+	}
+	for(; i < count; i++)
+	{
+		dest[i] = transformRGB565ToRGBX8888Impl<BGR_SWAP>(src[i]);
+	}
+}
+
+void transformLineRGB565ToRGBX8888(const uint16_t *src, size_t count, uint32_t *dest) { transformLineRGB565ToRGBX8888Impl(src, count, dest); }
+void transformLineRGB565ToBGRX8888(const uint16_t *src, size_t count, uint32_t *dest) { transformLineRGB565ToRGBX8888Impl<true>(src, count, dest); }
+
 template <bool BGR_SWAP = false>
 static uint32_t transformRGB888ToRGBX8888Impl(RGBTripleArray p)
 {
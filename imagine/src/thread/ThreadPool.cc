@@ -0,0 +1,155 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/thread/ThreadPool.hh>
+#include <imagine/logger/SystemLogger.hh>
+#include <imagine/util/ranges.hh>
+import std;
+
+namespace IG
+{
+
+static SystemLogger log{"ThreadPool"};
+
+// set on worker threads to find their own queue
+static thread_local const ThreadPool *currentPool{};
+static thread_local int currentWorkerIdx{};
+
+void ThreadPool::start(ThreadPoolConfig config)
+{
+	stop();
+	if(config.threads <= 0)
+		return;
+	workerCount = config.threads;
+	workers = std::make_unique<Worker[]>(workerCount);
+	threadIds_ = std::make_unique<ThreadId[]>(workerCount);
+	stopping.store(false, std::memory_order::relaxed);
+	for(auto i : iotaCount(workerCount))
+	{
+		workers[i].thread = makeThreadSync([this, i, nice = config.nice](auto &sem)
+		{
+			currentPool = this;
+			currentWorkerIdx = i;
+			threadIds_[i] = thisThreadId();
+			if(nice)
+				setThisThreadPriority(nice);
+			sem.release();
+			while(true)
+			{
+				workSem.acquire();
+				if(stopping.load(std::memory_order::relaxed))
+					return;
+				// the job may have already been taken by a thread waiting on its group
+				runNextJob(i, true);
+			}
+		});
+	}
+	if(config.cpuMask)
+		setCPUAffinityMask(config.cpuMask);
+	log.info("started {} worker thread(s) with CPU mask:{:X}", workerCount, config.cpuMask);
+}
+
+void ThreadPool::stop()
+{
+	if(!workerCount)
+		return;
+	stopping.store(true, std::memory_order::relaxed);
+	workSem.release(workerCount);
+	for(auto &w : std::span{workers.get(), size_t(workerCount)})
+	{
+		w.thread.join();
+		// run anything left so no TaskGroup is left waiting
+		for(auto &job : w.jobs)
+			runJob(job);
+	}
+	workers.reset();
+	threadIds_.reset();
+	workerCount = 0;
+}
+
+void ThreadPool::run(TaskGroup &group, Job job)
+{
+	if(!workerCount)
+	{
+		job();
+		return;
+	}
+	group.pending.fetch_add(1, std::memory_order::relaxed);
+	auto workerIdx = callingWorkerIdx();
+	if(workerIdx == -1)
+		workerIdx = nextQueue.fetch_add(1, std::memory_order::relaxed) % workerCount;
+	{
+		auto &w = workers[workerIdx];
+		std::scoped_lock lock{w.mutex};
+		w.jobs.emplace_back(job, &group);
+	}
+	workSem.release();
+}
+
+void ThreadPool::wait(TaskGroup &group)
+{
+	// drop the waiting thread's count, if it was the last one no jobs are left to wait on
+	if(group.pending.fetch_sub(1, std::memory_order::acq_rel) != 1)
+	{
+		// help with queued jobs, possibly from other groups, then sleep until the last one finishes
+		auto workerIdx = callingWorkerIdx();
+		while(workerCount && group.pending.load(std::memory_order::acquire)
+			&& runNextJob(workerIdx == -1 ? 0 : workerIdx, workerIdx != -1)) {}
+		group.done.acquire();
+	}
+	group.pending.store(1, std::memory_order::relaxed);
+}
+
+bool ThreadPool::runNextJob(int startIdx, bool ownsQueue)
+{
+	for(auto i : iotaCount(workerCount))
+	{
+		auto &w = workers[(startIdx + i) % workerCount];
+		QueuedJob job;
+		{
+			std::scoped_lock lock{w.mutex};
+			if(w.jobs.empty())
+				continue;
+			if(ownsQueue && i == 0)
+			{
+				job = w.jobs.back();
+				w.jobs.pop_back();
+			}
+			else
+			{
+				job = w.jobs.front();
+				w.jobs.pop_front();
+			}
+		}
+		runJob(job);
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::runJob(QueuedJob &job)
+{
+	job.job();
+	auto &group = *job.group;
+	if(group.pending.fetch_sub(1, std::memory_order::acq_rel) == 1)
+		group.done.release(); // the waiting thread may destroy the group after this
+}
+
+int ThreadPool::callingWorkerIdx() const
+{
+	return currentPool == this ? currentWorkerIdx : -1;
+}
+
+}
@@ -0,0 +1,91 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/thread/ThreadUsageCounter.hh>
+#include <imagine/logger/SystemLogger.hh>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
+import std;
+
+namespace IG
+{
+
+[[maybe_unused]] static SystemLogger log{"ThreadUsage"};
+
+#ifdef __linux__
+static UniqueFileDescriptor openSoftwareCounter(ThreadId id, uint64_t config)
+{
+	perf_event_attr attr{};
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_SOFTWARE;
+	attr.config = config;
+	attr.exclude_hv = 1;
+	return UniqueFileDescriptor{int(syscall(__NR_perf_event_open, &attr, id, -1, -1, 0))};
+}
+
+static uint64_t readCounter(int fd)
+{
+	uint64_t count{};
+	if(::read(fd, &count, sizeof(count)) != sizeof(count))
+		return 0;
+	return count;
+}
+
+static Nanoseconds readSchedStatCPUTime(ThreadId id)
+{
+	// first field is the time spent running in nanoseconds
+	auto path = std::format("/proc/self/task/{}/schedstat", id);
+	UniqueFileDescriptor fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+	if(fd == -1)
+		return {};
+	std::array<char, 64> buff{};
+	if(::read(fd, buff.data(), buff.size() - 1) <= 0)
+		return {};
+	return Nanoseconds{std::strtoll(buff.data(), nullptr, 10)};
+}
+#endif
+
+ThreadUsageCounter::ThreadUsageCounter(ThreadId id):
+	id{id}
+{
+	#ifdef __linux__
+	cpuClockFd = openSoftwareCounter(id, PERF_COUNT_SW_TASK_CLOCK);
+	if(cpuClockFd == -1)
+		log.info("perf events unavailable for thread:{}, error:{}", id, std::strerror(errno));
+	else
+		migrationsFd = openSoftwareCounter(id, PERF_COUNT_SW_CPU_MIGRATIONS);
+	#endif
+}
+
+ThreadUsage ThreadUsageCounter::usage() const
+{
+	#ifdef __linux__
+	if(cpuClockFd == -1)
+		return {.cpuTime = readSchedStatCPUTime(id)};
+	ThreadUsage u{.cpuTime = Nanoseconds(readCounter(cpuClockFd))};
+	if(migrationsFd != -1)
+		u.migrations = readCounter(migrationsFd);
+	return u;
+	#else
+	return {};
+	#endif
+}
+
+}
@@ -54,6 +54,24 @@ void setThreadCPUAffinityMask([[maybe_unused]] std::span<const ThreadId> ids, [[
 	#endif
 }
 
+CPUMask threadCPUAffinityMask([[maybe_unused]] ThreadId id)
+{
+	#ifdef __linux__
+	cpu_set_t cpuSet{};
+	if(syscall(__NR_sched_getaffinity, id, sizeof(cpuSet), &cpuSet) == -1)
+	{
+		if(Config::DEBUG_BUILD)
+			log.error("error:{} getting thread:{:X} CPU affinity", std::strerror(errno), id);
+		return 0;
+	}
+	CPUMask mask{};
+	std::memcpy(&mask, &cpuSet, sizeof(mask));
+	return mask;
+	#else
+	return 0;
+	#endif
+}
+
 void setThreadPriority([[maybe_unused]] ThreadId id, [[maybe_unused]] int nice)
 {
 	#ifdef __linux__
@@ -62,6 +80,21 @@ void setThreadPriority([[maybe_unused]] ThreadId id, [[maybe_unused]] int nice)
 	#endif
 }
 
+bool setThreadRealtimePriority([[maybe_unused]] ThreadId id, [[maybe_unused]] int priority)
+{
+	#ifdef __linux__
+	sched_param param{.sched_priority = std::max(priority, 0)};
+	if(sched_setscheduler(id, priority > 0 ? SCHED_FIFO : SCHED_OTHER, &param))
+	{
+		log.error("error:{} setting thread:{} real-time priority:{}", std::strerror(errno), id, priority);
+		return false;
+	}
+	return true;
+	#else
+	return false;
+	#endif
+}
+
 void setThisThreadPriority([[maybe_unused]] int nice)
 {
 	#ifdef __linux__
@@ -18,6 +18,8 @@
 #include <imagine/logger/SystemLogger.hh>
 #include <sys/mman.h>
 #include <unistd.h>
+#include <errno.h>
+#include <cstring>
 #if defined __ANDROID__ && ANDROID_MIN_API <= 24
 #define NEEDS_MREMAP_SYSCALL
 #include <unistd.h>
@@ -55,6 +57,57 @@ std::span<uint8_t> vAlloc(size_t bytes)
 	return vAlloc(bytes, false);
 }
 
+std::span<uint8_t> vAlloc(size_t bytes, VMemFlags flags)
+{
+	constexpr uintptr_t hugePageSize = 2 * 1024 * 1024;
+	if(!flags.hugePages || bytes < hugePageSize)
+	{
+		auto buff = vAlloc(bytes, false);
+		vApplyFlags(buff, flags);
+		return buff;
+	}
+	// over-allocate so the buffer can start on a huge page boundary and trim off the rest,
+	// otherwise the kernel can only use huge pages for the aligned middle of the range
+	auto mapBytes = roundPageSize(bytes);
+	auto mapBuff = vAlloc(mapBytes + hugePageSize, false);
+	if(!mapBuff.data()) [[unlikely]]
+		return {};
+	auto addr = std::bit_cast<uintptr_t>(mapBuff.data());
+	auto alignedAddr = (addr + hugePageSize - 1) & ~(hugePageSize - 1);
+	auto headBytes = alignedAddr - addr;
+	if(headBytes)
+		munmap(mapBuff.data(), headBytes);
+	if(auto tailBytes = mapBuff.size() - headBytes - mapBytes)
+		munmap(mapBuff.data() + headBytes + mapBytes, tailBytes);
+	std::span<uint8_t> buff{mapBuff.data() + headBytes, bytes};
+	vApplyFlags(buff, flags);
+	return buff;
+}
+
+void vApplyFlags(std::span<uint8_t> buff, VMemFlags flags)
+{
+	auto start = roundPageSize(buff.data());
+	auto end = truncPageSize(buff.data() + buff.size());
+	if(start >= end)
+		return;
+	size_t bytes = end - start;
+	#ifdef MADV_HUGEPAGE
+	if(flags.hugePages && madvise(start, bytes, MADV_HUGEPAGE))
+	{
+		log.warn("error:{} in madvise(MADV_HUGEPAGE) for {} ({} bytes)", std::strerror(errno), (void*)start, bytes);
+	}
+	#endif
+	if(flags.locked)
+	{
+		if(mlock(start, bytes))
+			log.warn("error:{} locking {} ({} bytes)", std::strerror(errno), (void*)start, bytes);
+	}
+	else
+	{
+		munlock(start, bytes);
+	}
+}
+
 void vFree(std::span<uint8_t> buff)
 {
 	if(!buff.data())
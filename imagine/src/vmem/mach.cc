@@ -19,6 +19,9 @@
 #include <mach/mach.h>
 #include <mach/vm_map.h>
 #include <mach/machine/vm_param.h>
+#include <sys/mman.h>
+#include <errno.h>
+#include <cstring>
 
 namespace IG
 {
@@ -37,6 +40,32 @@ std::span<uint8_t> vAlloc(size_t bytes)
 	return {reinterpret_cast<uint8_t*>(addr), bytes};
 }
 
+std::span<uint8_t> vAlloc(size_t bytes, VMemFlags flags)
+{
+	auto buff = vAlloc(bytes);
+	vApplyFlags(buff, flags);
+	return buff;
+}
+
+void vApplyFlags(std::span<uint8_t> buff, VMemFlags flags)
+{
+	// huge pages aren't exposed for regular allocations, only locking is supported
+	auto start = roundPageSize(buff.data());
+	auto end = truncPageSize(buff.data() + buff.size());
+	if(start >= end)
+		return;
+	size_t bytes = end - start;
+	if(flags.locked)
+	{
+		if(mlock(start, bytes))
+			log.warn("error:{} locking {} ({} bytes)", std::strerror(errno), (void*)start, bytes);
+	}
+	else
+	{
+		munlock(start, bytes);
+	}
+}
+
 void vFree(std::span<uint8_t> buff)
 {
 	if(!buff.data())